@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "book.h"
+#include "taxonset.h"
+#include "fnv.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+
+
+namespace {
+
+    const size_t block_size = 1 << 20;
+}
+
+
+Book::Book()
+    : pool(1),
+      slots(64),
+      p(0),
+      left(0)
+{}
+
+
+/**
+ * Add 'ex', and return its index.
+ */
+size_t Book::add(const FieldList& ex)
+{
+    return append(ex);
+}
+
+
+/**
+ * Like add(const FieldList&); the Book gets a copy of the text 'ex'
+ * refers to, so it needn't stay around.
+ */
+size_t Book::add(const FieldView& ex)
+{
+    return append(ex);
+}
+
+
+template<class Ex>
+size_t Book::append(const Ex& ex)
+{
+    const size_t n = records.size();
+    Record r {uint32_t(headers.size()),
+	      uint32_t(sightings.size()),
+	      uint32_t(taxa.size()),
+	      {{}}, ex.coordinate, ex.date};
+    /* The first of a known header counts, even if it's empty and
+     * so looks like one which isn't there.
+     */
+    unsigned seen = 0;
+    for(auto i = ex.hbegin(); i!=ex.hend(); i++) {
+	const Field f {intern(i->name), intern(i->value)};
+	headers.push_back(f);
+	const Text& name = pool[f.name];
+	const header::Known k = header::known(name.a, name.n);
+	if(k==header::OTHER || seen & 1u << k) continue;
+	seen |= 1u << k;
+	r.known[k] = f.value;
+    }
+    for(auto i = ex.sbegin(); i!=ex.send(); i++) {
+	sightings.push_back({i->sp, intern(i->name), text(i->comment)});
+	taxa.push_back(i->sp);
+    }
+    const auto t = taxa.begin() + r.t;
+    std::sort(t, taxa.end());
+    taxa.erase(std::unique(t, taxa.end()), taxa.end());
+
+    records.push_back(r);
+    return n;
+}
+
+
+/**
+ * Remove all excursions, and free the memory they used.
+ */
+void Book::clear()
+{
+    std::vector<Record>().swap(records);
+    std::vector<Field>().swap(headers);
+    std::vector<Seen>().swap(sightings);
+    std::vector<TaxonId>().swap(taxa);
+    std::vector<Text>(1).swap(pool);
+    std::vector<uint32_t>(64).swap(slots);
+    blocks.clear();
+    p = 0;
+    left = 0;
+}
+
+
+Book::Entry Book::operator[] (const size_t i) const
+{
+    return Entry(*this, i);
+}
+
+
+Book::const_iterator Book::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+
+Book::const_iterator Book::end() const
+{
+    return const_iterator(this, records.size());
+}
+
+
+/**
+ * Helper. Copy [s, s+n) into the blocks, and return where it went.
+ * Large strings get a block of their own.
+ */
+const char* Book::copy(const char* s, const size_t n)
+{
+    if(!n) return "";
+    if(n > left) {
+	const size_t size = std::max(n, block_size);
+	blocks.emplace_back(new char[size]);
+	char* const q = blocks.back().get();
+	if(size==n) {
+	    std::memcpy(q, s, n);
+	    return q;
+	}
+	p = q;
+	left = size;
+    }
+    char* const q = p;
+    std::memcpy(q, s, n);
+    p += n;
+    left -= n;
+    return q;
+}
+
+
+Book::Text Book::text(const std::string& s)
+{
+    return Text(copy(s.data(), s.size()), s.size());
+}
+
+
+/**
+ * Helper. A copy of 's', with any continuation lines joined.
+ */
+Book::Text Book::text(const Text& s)
+{
+    if(s.simple()) return Text(copy(s.a, s.n), s.n);
+    buf.clear();
+    s.append_to(buf);
+    return text(buf);
+}
+
+
+/**
+ * Helper. The id of [s, s+n), which is stored once no matter how many
+ * times it's interned.  The empty string is 0.
+ */
+uint32_t Book::intern(const char* s, const size_t n)
+{
+    if(!n) return 0;
+    uint32_t id = find(s, n);
+    if(id) return id;
+
+    id = pool.size();
+    pool.push_back(Text(copy(s, n), n));
+    if(2 * pool.size() > slots.size()) {
+	rehash();
+    }
+    else {
+	const uint32_t mask = slots.size() - 1;
+	uint32_t i = fnv1a(s, n) & mask;
+	while(slots[i]) i = (i + 1) & mask;
+	slots[i] = id;
+    }
+    return id;
+}
+
+
+uint32_t Book::intern(const std::string& s)
+{
+    return intern(s.data(), s.size());
+}
+
+
+uint32_t Book::intern(const Text& s)
+{
+    if(s.simple()) return intern(s.a, s.n);
+    buf.clear();
+    s.append_to(buf);
+    return intern(buf);
+}
+
+
+/**
+ * Helper. The id of [s, s+n) if it has been interned, or else 0.
+ */
+uint32_t Book::find(const char* s, const size_t n) const
+{
+    const uint32_t mask = slots.size() - 1;
+    uint32_t i = fnv1a(s, n) & mask;
+    while(const uint32_t id = slots[i]) {
+	const Text& t = pool[id];
+	if(t.n==n && std::memcmp(t.a, s, n)==0) return id;
+	i = (i + 1) & mask;
+    }
+    return 0;
+}
+
+
+/**
+ * Helper. Double the size of the hash table, and reinsert everything
+ * in the pool.
+ */
+void Book::rehash()
+{
+    std::vector<uint32_t> v(2 * slots.size());
+    const uint32_t mask = v.size() - 1;
+    for(const uint32_t id : slots) {
+	if(!id) continue;
+	const Text& t = pool[id];
+	uint32_t i = fnv1a(t.a, t.n) & mask;
+	while(v[i]) i = (i + 1) & mask;
+	v[i] = id;
+    }
+    slots.swap(v);
+}
+
+
+FieldView::Header Book::get(const Field& f) const
+{
+    Header h(0, 0, 0, 0);
+    h.name = pool[f.name];
+    h.value = pool[f.value];
+    return h;
+}
+
+
+FieldView::Sighting Book::get(const Seen& s) const
+{
+    Sighting sg(s.sp, 0, 0, 0, 0);
+    sg.name = pool[s.name];
+    sg.comment = s.comment;
+    return sg;
+}
+
+
+Book::Entry::Entry(const Book& book, const size_t i)
+    : date(book.records[i].date),
+      place(book.pool[book.records[i].known[header::PLACE]]),
+      coordinate(book.records[i].coordinate),
+      place_id(book.records[i].known[header::PLACE]),
+      book(book),
+      r(book.records[i])
+{
+    const bool last = i+1 == book.records.size();
+    const Record* const next = last ? 0 : &book.records[i+1];
+    h = book.headers.data() + r.h;
+    he = book.headers.data() + (next ? next->h : book.headers.size());
+    s = book.sightings.data() + r.s;
+    se = book.sightings.data() + (next ? next->s : book.sightings.size());
+    t = book.taxa.data() + r.t;
+    te = book.taxa.data() + (next ? next->t : book.taxa.size());
+}
+
+
+bool Book::Entry::has_one(const std::vector<TaxonId>& taxa) const
+{
+    for(TaxonId sp : taxa) {
+	if(contains(sp)) return true;
+    }
+    return false;
+}
+
+
+bool Book::Entry::has_one(const TaxonSet& taxa) const
+{
+    return std::any_of(t, te,
+		       [&taxa] (TaxonId sp) { return taxa.contains(sp); });
+}
+
+
+bool Book::Entry::contains(const TaxonId taxon) const
+{
+    return std::binary_search(t, te, taxon);
+}
+
+
+bool Book::Entry::has_header(const std::string& name) const
+{
+    const uint32_t id = book.find(name.data(), name.size());
+    if(!id) return false;
+    return std::find_if(h, he,
+			[id] (const Field& f) { return f.name==id; })
+	!= he;
+}
+
+
+const FieldView::Text& Book::Entry::find_header(const char* name) const
+{
+    const size_t n = std::strlen(name);
+    const header::Known k = header::known(name, n);
+    if(k!=header::OTHER) return header(k);
+    const uint32_t id = book.find(name, n);
+    auto i = std::find_if(h, he,
+			  [id] (const Field& f) { return f.name==id; });
+    if(!id || i==he) return book.pool[0];
+    return book.pool[i->value];
+}
+
+
+const FieldView::Text& Book::Entry::header(const header::Known name) const
+{
+    return book.pool[r.known[name]];
+}
+
+
+/**
+ * Make 'ex' a FieldList with the same contents.
+ */
+void Book::Entry::copy(FieldList& ex) const
+{
+    FieldList f;
+    for(auto i = hbegin(); i!=hend(); i++) {
+	f.add_header(i->name.a, i->name.n, i->value.a, i->value.n);
+    }
+    for(auto i = sbegin(); i!=send(); i++) {
+	f.add_sighting(i->sp, i->name.a, i->name.n,
+		       i->comment.a, i->comment.n);
+    }
+    f.finalize(date);
+    ex.swap(f);
+}
+
+
+std::ostream& Book::Entry::put(std::ostream& os, const bool sort) const
+{
+    FieldList f;
+    copy(f);
+    return f.put(os, sort);
+}
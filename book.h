@@ -0,0 +1,204 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_BOOK_H
+#define GROBLAD_BOOK_H
+
+#include "fieldview.h"
+
+#include <vector>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+
+
+/**
+ * Many excursions, packed tightly: the text of all of them in a few
+ * large blocks, and their headers and sightings in two arrays, in
+ * the order they were add()ed.  An excursion is found by its index,
+ * which never changes, and looks like a FieldView.  Everything is
+ * freed at once.
+ *
+ * What most scans look at -- the date, the known headers, the parsed
+ * coordinate and which taxa were seen -- is kept apart from the rest,
+ * in a small record and a sorted array of TaxonIds.  Headers, names
+ * and comments are only touched when someone iterates over them or
+ * prints them.
+ *
+ * Header names and values, and the names of sightings, repeat a lot
+ * and are interned: each distinct string is stored once, and what's
+ * stored per excursion is a small id for it.  So excursions with the
+ * same place have the same place_id.  Sighting comments are mostly
+ * unique, and aren't interned.
+ *
+ * Entries are valid until the next add(); their text until clear().
+ */
+class Book {
+public:
+    class Entry;
+    class const_iterator;
+    template<class T, class Stored> class Iterator;
+
+    Book();
+
+    size_t add(const FieldList& ex);
+    size_t add(const FieldView& ex);
+    void clear();
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+    Entry operator[] (size_t i) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    Book(const Book&);
+    Book& operator= (const Book&);
+
+    typedef FieldView::Text Text;
+    typedef FieldView::Header Header;
+    typedef FieldView::Sighting Sighting;
+
+    template<class Ex> size_t append(const Ex& ex);
+    const char* copy(const char* s, size_t n);
+    Text text(const std::string& s);
+    Text text(const Text& s);
+    uint32_t intern(const std::string& s);
+    uint32_t intern(const Text& s);
+    uint32_t intern(const char* s, size_t n);
+    uint32_t find(const char* s, size_t n) const;
+    void rehash();
+
+    struct Record {
+	uint32_t h;
+	uint32_t s;
+	uint32_t t;
+	std::array<uint32_t, header::OTHER> known;
+	Coordinate coordinate;
+	Date date;
+    };
+    struct Field {
+	uint32_t name;
+	uint32_t value;
+    };
+    struct Seen {
+	TaxonId sp;
+	uint32_t name;
+	Text comment;
+    };
+    Header get(const Field& f) const;
+    Sighting get(const Seen& s) const;
+
+    std::vector<Record> records;
+    std::vector<TaxonId> taxa;
+    std::vector<Field> headers;
+    std::vector<Seen> sightings;
+
+    std::vector<Text> pool;
+    std::vector<uint32_t> slots;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* p;
+    size_t left;
+    std::string buf;
+};
+
+
+/**
+ * Iterating over the Fields or Seens of an excursion, as if they
+ * were FieldView Headers or Sightings.
+ */
+template<class T, class Stored>
+class Book::Iterator {
+public:
+    struct Arrow {
+	T val;
+	const T* operator-> () const { return &val; }
+    };
+
+    T operator* () const { return book->get(*p); }
+    Arrow operator-> () const { return Arrow{**this}; }
+    Iterator& operator++ () { p++; return *this; }
+    Iterator operator++ (int) { Iterator i = *this; p++; return i; }
+    bool operator== (const Iterator& other) const { return p==other.p; }
+    bool operator!= (const Iterator& other) const { return p!=other.p; }
+    ptrdiff_t operator- (const Iterator& other) const { return p - other.p; }
+
+private:
+    friend class Book;
+    Iterator(const Book* book, const Stored* p) : book(book), p(p) {}
+    const Book* book;
+    const Stored* p;
+};
+
+
+/**
+ * One of the excursions in a Book.
+ */
+class Book::Entry {
+public:
+    typedef Iterator<FieldView::Header, Field> header_iterator;
+    typedef Iterator<FieldView::Sighting, Seen> sighting_iterator;
+    typedef const TaxonId* taxon_iterator;
+
+    header_iterator hbegin() const { return {&book, h}; }
+    header_iterator hend() const { return {&book, he}; }
+    sighting_iterator sbegin() const { return {&book, s}; }
+    sighting_iterator send() const { return {&book, se}; }
+    taxon_iterator tbegin() const { return t; }
+    taxon_iterator tend() const { return te; }
+
+    bool has_one(const std::vector<TaxonId>& taxa) const;
+    bool has_one(const TaxonSet& taxa) const;
+    bool contains(TaxonId taxon) const;
+    bool has_header(const std::string& name) const;
+    const FieldView::Text& find_header(const char* name) const;
+    const FieldView::Text& header(header::Known name) const;
+
+    void copy(FieldList& ex) const;
+    std::ostream& put(std::ostream& os, bool sort = false) const;
+
+    const Date& date;
+    const FieldView::Text& place;
+    const Coordinate& coordinate;
+    const unsigned place_id;
+
+private:
+    friend class Book;
+    Entry(const Book& book, size_t i);
+
+    const Book& book;
+    const Record& r;
+    const Field* h;
+    const Field* he;
+    const Seen* s;
+    const Seen* se;
+    taxon_iterator t;
+    taxon_iterator te;
+};
+
+
+class Book::const_iterator {
+public:
+    Entry operator* () const { return (*book)[i]; }
+    const_iterator& operator++ () { i++; return *this; }
+    bool operator== (const const_iterator& other) const { return i==other.i; }
+    bool operator!= (const const_iterator& other) const { return i!=other.i; }
+
+private:
+    friend class Book;
+    const_iterator(const Book* book, size_t i) : book(book), i(i) {}
+    const Book* book;
+    size_t i;
+};
+
+
+inline
+std::ostream& operator<< (std::ostream& os, const Book::Entry& val)
+{
+    return val.put(os);
+}
+
+#endif
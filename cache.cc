@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "cache.h"
+
+#include "excursion.h"
+#include "fieldview.h"
+#include "taxa.h"
+#include "replace.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/* The file is a header:
+ *
+ *   magic       16 octets
+ *   book digest 16 octets
+ *   taxa digest 16 octets
+ *   book length u64
+ *   book lines  u32, and u32 zero
+ *   book stamp  u64 size, u64 inode, u64 mtime seconds, u64 nanoseconds
+ *
+ * followed by records until the end, in host byte order:
+ *
+ *   diagnostics   string
+ *   marks         u32 count, u32 offset ...
+ *   present       u32
+ *   excursion     if present: u32 date value, string date rest,
+ *                 u32 count, (string name, string value) ...
+ *                 u32 count, (u32 taxon, string name, string comment) ...
+ *
+ * where a string is a u32 length and the octets.  The diagnostics
+ * are those which get() printed up to and including this excursion,
+ * but with the book's file name removed at the 'marks', so that it
+ * doesn't matter what the book is called when it's read back.
+ *
+ * The stamp is the book's when its digest was computed -- or all
+ * zeros, if it had been modified so recently that a later change
+ * might not show in the modification time.
+ */
+namespace {
+
+    const char magic[16] = "groblad cache 3";
+    const char index_magic[16] = "groblad index 3";
+    const size_t stamp_size = 4 * 8;
+    const size_t head_size = 4 * 16 + stamp_size;
+
+    /**
+     * "foo/.bar.suffix" for the book "foo/bar".
+     */
+    std::string path_of(const std::string& book, const char* suffix)
+    {
+	const size_t n = book.rfind('/') + 1;
+	std::string s = book.substr(0, n);
+	s += '.';
+	s.append(book, n, std::string::npos);
+	s += suffix;
+	return s;
+    }
+
+    /**
+     * The size, inode and modification time of a file.
+     */
+    std::string stamp(const struct stat& st)
+    {
+	const uint64_t v[4] = { uint64_t(st.st_size),
+				uint64_t(st.st_ino),
+				uint64_t(st.st_mtim.tv_sec),
+				uint64_t(st.st_mtim.tv_nsec) };
+	return std::string(reinterpret_cast<const char*>(v), sizeof v);
+    }
+
+    md5::Digest digest(const Taxa& spp)
+    {
+	md5::Ctx ctx;
+	const char nul = 0;
+	for(const Taxon& sp : spp) {
+	    ctx.update(sp.genus ? "g" : "s", 1);
+	    ctx.update(sp.name).update(&nul, 1);
+	    ctx.update(sp.latin).update(&nul, 1);
+	    for(const std::string& s : sp.alias) {
+		ctx.update(s).update(&nul, 1);
+	    }
+	    ctx.update("\n", 1);
+	}
+	return ctx.digest();
+    }
+
+    /**
+     * Reading [p, e) from the front, without reading past e.
+     * Anything read after running out is zero or empty.
+     */
+    struct Reader {
+	Reader(const char* p, const char* e) : p(p), e(e), ok(true) {}
+	const char* p;
+	const char* const e;
+	bool ok;
+
+	bool more() const { return ok && p!=e; }
+	const char* take(size_t n) {
+	    if(size_t(e - p) < n) {
+		ok = false;
+		p = e;
+		return 0;
+	    }
+	    const char* q = p;
+	    p += n;
+	    return q;
+	}
+	uint32_t u32() {
+	    uint32_t n = 0;
+	    const char* q = take(sizeof n);
+	    if(q) std::memcpy(&n, q, sizeof n);
+	    return n;
+	}
+	size_t str(const char*& s) {
+	    const uint32_t n = u32();
+	    s = take(n);
+	    return s ? n : 0;
+	}
+	std::string str() {
+	    const char* s;
+	    const size_t n = str(s);
+	    return s ? std::string(s, n) : std::string();
+	}
+    };
+
+    void put(std::string& buf, const uint32_t n)
+    {
+	buf.append(reinterpret_cast<const char*>(&n), sizeof n);
+    }
+
+    void put64(std::string& buf, const uint64_t n)
+    {
+	buf.append(reinterpret_cast<const char*>(&n), sizeof n);
+    }
+
+    void put(std::string& buf, const std::string& s)
+    {
+	put(buf, s.size());
+	buf.append(s);
+    }
+}
+
+
+Cache::Cache(const std::string& book)
+    : book(book),
+      path(path_of(book, ".cache")),
+      hashed(false),
+      regular(false),
+      whole(false),
+      book_length(0),
+      book_lines(0),
+      p(0)
+{
+    if(book=="-") return;
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd==-1) return;
+    Mmap m(fd);
+    close(fd);
+    map.swap(m);
+    if(map.valid()) p = map.begin() + head_size;
+}
+
+
+/**
+ * True if there's a cache, and it was made from the book's current
+ * contents.  That's taken for granted if the book has the stamp the
+ * cache was made with; otherwise the book is hashed to find out.
+ */
+bool Cache::fresh()
+{
+    if(map.size() < head_size) return false;
+    if(std::memcmp(map.begin(), magic, sizeof magic)) return false;
+
+    struct stat st;
+    if(!hashed && !stat(book.c_str(), &st) && S_ISREG(st.st_mode)) {
+	const std::string s = ::stamp(st);
+	if(std::memcmp(map.begin() + 64, s.data(), stamp_size)==0) return true;
+    }
+
+    if(!hash()) return false;
+    return std::memcmp(map.begin() + 16, digest.val, 16)==0;
+}
+
+
+/**
+ * True if there's a cache, but it was made when the book was only
+ * the first length() octets of what it is now.  This is the case
+ * after appending complete lines to it.
+ */
+bool Cache::appended()
+{
+    if(map.size() < head_size) return false;
+    if(std::memcmp(map.begin(), magic, sizeof magic)) return false;
+    if(!hash()) return false;
+    if(!whole || length() >= book_length) return false;
+    return std::memcmp(map.begin() + 16, covered.val, 16)==0;
+}
+
+
+/**
+ * The size of the book, and its number of lines, when the cache
+ * was made.
+ */
+size_t Cache::length() const
+{
+    uint64_t n = 0;
+    if(map.size() >= head_size) std::memcpy(&n, map.begin() + 48, sizeof n);
+    return n;
+}
+
+
+unsigned Cache::lines() const
+{
+    uint32_t n = 0;
+    if(map.size() >= head_size) std::memcpy(&n, map.begin() + 56, sizeof n);
+    return n;
+}
+
+
+/**
+ * True if the cache was made using taxa 'spp' (as they looked when
+ * get() started on the book).
+ */
+bool Cache::fits(const Taxa& spp) const
+{
+    if(map.size() < head_size) return false;
+    const md5::Digest d = ::digest(spp);
+    return std::memcmp(map.begin() + 32, d.val, 16)==0;
+}
+
+
+/**
+ * Like get(Files&, std::ostream&, Taxa&, Excursion&), for the next
+ * excursion in the cache.
+ */
+bool Cache::get(std::ostream& err, Taxa& spp, FieldList& ex)
+{
+    return next(err, spp, ex);
+}
+
+
+/**
+ * Like get() above, but the view refers to the cache itself, until
+ * it's destroyed.
+ */
+bool Cache::get(std::ostream& err, Taxa& spp, FieldView& ex)
+{
+    return next(err, spp, ex);
+}
+
+
+template<class Ex>
+bool Cache::next(std::ostream& err, Taxa& spp, Ex& ex)
+{
+    if(!map.valid()) return false;
+    Reader in(p, map.end());
+
+    while(in.more()) {
+	const char* s;
+	size_t n = in.str(s);
+	const char* const s_end = s + n;
+	size_t prev = 0;
+	for(uint32_t i = in.u32(); i; i--) {
+	    const size_t mark = std::min(size_t(in.u32()), n);
+	    err.write(s + prev, mark - prev);
+	    err << book;
+	    prev = mark;
+	}
+	err.write(s + prev, s_end - s - prev);
+
+	if(!in.u32()) {
+	    p = in.p;
+	    continue;
+	}
+
+	Ex f;
+	const unsigned val = in.u32();
+	const Date date(val, in.str());
+
+	for(uint32_t i = in.u32(); i; i--) {
+	    const char* a;
+	    const size_t alen = in.str(a);
+	    const char* b;
+	    const size_t blen = in.str(b);
+	    f.add_header(a, alen, b, blen);
+	}
+
+	const unsigned known = spp.end() - spp.begin();
+	for(uint32_t i = in.u32(); i; i--) {
+	    TaxonId sp(in.u32());
+	    const char* a;
+	    const size_t alen = in.str(a);
+	    const char* b;
+	    const size_t blen = in.str(b);
+	    if(sp.val > known) {
+		/* one get() invented, and so do we */
+		sp = spp.find(a, alen);
+		if(!sp) sp = spp.insert(std::string(a, alen));
+	    }
+	    f.add_sighting(sp, a, alen, b, blen);
+	}
+	f.finalize(date);
+
+	p = in.p;
+	if(!in.ok) break;
+	ex.swap(f);
+	return true;
+    }
+
+    p = map.end();
+    return false;
+}
+
+
+/**
+ * Helper. Find the book's digest, and that of the part of it the
+ * cache covers -- or find that it isn't a regular file which could
+ * be cached.
+ */
+bool Cache::hash()
+{
+    if(hashed) return regular;
+    hashed = true;
+    if(book=="-") return false;
+
+    const int fd = open(book.c_str(), O_RDONLY);
+    if(fd==-1) return false;
+    struct stat st;
+    if(fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+	close(fd);
+	return false;
+    }
+    /* Modified this second or the one before, it may be modified
+     * again without getting a new modification time.
+     */
+    if(st.st_mtim.tv_sec < std::time(0) - 1) stamp = ::stamp(st);
+    else stamp.assign(stamp_size, '\0');
+    Mmap m(fd);
+    close(fd);
+    if(!m.valid()) return false;
+
+    const char* const a = m.begin();
+    const size_t n = length();
+    md5::Ctx ctx;
+    if(n && n < m.size()) {
+	ctx.update(a, n);
+	covered = ctx.digest();
+	whole = a[n-1]=='\n';
+	ctx.update(a + n, m.size() - n);
+    }
+    else {
+	ctx.update(a, m.size());
+    }
+    digest = ctx.digest();
+    book_length = m.size();
+    book_lines = std::count(a, m.end(), '\n');
+    regular = true;
+    return true;
+}
+
+
+Cache::Writer::Writer(Cache& cache, const Taxa& spp)
+    : book(cache.book),
+      path(cache.path),
+      known(spp.end() - spp.begin()),
+      postings(known + 1)
+{
+    if(!cache.hash()) return;
+
+    file.reset(new Replacement(path, book));
+    if(!file->valid()) return;
+
+    /* the same for the cache and the index */
+    head.append(reinterpret_cast<const char*>(cache.digest.val), 16);
+    const md5::Digest d = ::digest(spp);
+    head.append(reinterpret_cast<const char*>(d.val), 16);
+    put64(head, cache.book_length);
+    put(head, cache.book_lines);
+    put(head, 0);
+    head.append(cache.stamp);
+
+    buf.append(magic, sizeof magic);
+    buf.append(head);
+}
+
+
+Cache::Writer::~Writer()
+{}
+
+
+/**
+ * Start with the excursions in 'cache', which is for the start of
+ * the same book, and its 'index' -- so only the rest of the book
+ * needs to be add()ed.
+ */
+void Cache::Writer::keep(const Cache& cache, const Index& index)
+{
+    if(!file || !file->valid()) return;
+    flush();
+    file->write(cache.map.begin() + head_size, cache.map.end());
+    if(!file->valid()) return;
+
+    offsets.assign(index.offsets, index.offsets + index.n);
+    lines.assign(index.lines, index.lines + index.n);
+    for(unsigned id = 0; id <= index.ntaxa && id <= known; id++) {
+	postings[id].assign(index.postings + index.first[id],
+			    index.postings + index.first[id+1]);
+    }
+    invented = index.invented();
+}
+
+
+/**
+ * Add an excursion, and the diagnostics get() printed while reading
+ * it, starting at 'offset' in the book, on line 'line'.
+ */
+void Cache::Writer::add(const std::string& err, const FieldList& ex,
+			const size_t offset, const unsigned line)
+{
+    if(!file || !file->valid()) return;
+
+    const uint32_t n = offsets.size();
+    offsets.push_back(offset);
+    lines.push_back(line);
+    for(auto i = ex.sbegin(); i!=ex.send(); i++) {
+	if(i->sp.val > known) continue;
+	std::vector<uint32_t>& v = postings[i->sp.val];
+	if(v.empty() || v.back()!=n) v.push_back(n);
+    }
+    for(auto i = ex.sbegin(); i!=ex.send(); i++) {
+	if(i->sp.val == known + invented.size() + 1) {
+	    invented.push_back({n, i->name});
+	}
+    }
+
+    diagnostics(err);
+    put(buf, 1);
+    put(buf, ex.date.value());
+    put(buf, ex.date.rest());
+
+    put(buf, ex.hend() - ex.hbegin());
+    for(auto i = ex.hbegin(); i!=ex.hend(); i++) {
+	put(buf, i->name);
+	put(buf, i->value);
+    }
+
+    put(buf, ex.send() - ex.sbegin());
+    for(auto i = ex.sbegin(); i!=ex.send(); i++) {
+	put(buf, i->sp.val);
+	put(buf, i->name);
+	put(buf, i->comment);
+    }
+
+    if(buf.size() >= 1 << 20) flush();
+}
+
+
+void Cache::Writer::diagnostics(const std::string& err)
+{
+    std::string s;
+    std::vector<uint32_t> marks;
+    size_t i = 0;
+    while(i < err.size()) {
+	if(err.compare(i, book.size(), book)==0 &&
+	   err.size() > i + book.size() &&
+	   err[i + book.size()]==':') {
+	    marks.push_back(s.size());
+	    i += book.size();
+	}
+	size_t nl = err.find('\n', i);
+	nl = nl==std::string::npos ? err.size() : nl + 1;
+	s.append(err, i, nl - i);
+	i = nl;
+    }
+
+    put(buf, s);
+    put(buf, marks.size());
+    for(uint32_t n : marks) put(buf, n);
+}
+
+
+/**
+ * Put the new cache in place, returning true if that worked.
+ */
+bool Cache::Writer::commit()
+{
+    if(!file) return false;
+
+    flush();
+    const bool ok = file->commit();
+    if(ok) write_index();
+    return ok;
+}
+
+
+void Cache::Writer::flush()
+{
+    file->write(buf);
+    buf.clear();
+}
+
+
+/**
+ * Helper for commit(). The index is small enough to write in one go.
+ */
+void Cache::Writer::write_index()
+{
+    const std::string ipath = path_of(book, ".index");
+    Replacement index(ipath, book);
+    if(!index.valid()) return;
+
+    std::string b;
+    b.append(index_magic, sizeof index_magic);
+    b.append(head);
+    put(b, known);
+    put(b, offsets.size());
+    for(uint64_t n : offsets) put64(b, n);
+    for(uint32_t n : lines) put(b, n);
+    uint32_t first = 0;
+    for(const auto& v : postings) {
+	put(b, first);
+	first += v.size();
+    }
+    put(b, first);
+    for(const auto& v : postings) {
+	for(uint32_t n : v) put(b, n);
+    }
+    put(b, invented.size());
+    for(const auto& name : invented) {
+	put(b, name.first);
+	put(b, name.second);
+    }
+
+    index.write(b);
+    index.commit();
+}
+
+
+Index::Index(Cache& cache)
+    : ok(false),
+      ntaxa(0),
+      n(0),
+      offsets(0),
+      lines(0),
+      first(0),
+      postings(0),
+      names(0)
+{
+    const int fd = open(path_of(cache.book, ".index").c_str(), O_RDONLY);
+    if(fd==-1) return;
+    Mmap m(fd);
+    close(fd);
+    map.swap(m);
+
+    Reader in(map.begin(), map.end());
+    const char* const head = in.take(head_size);
+    ntaxa = in.u32();
+    n = in.u32();
+    offsets = reinterpret_cast<const uint64_t*>(in.take(n * 8));
+    lines = reinterpret_cast<const uint32_t*>(in.take(n * 4));
+    first = reinterpret_cast<const uint32_t*>(in.take((ntaxa + 2) * 4));
+    if(!in.ok) return;
+    postings = reinterpret_cast<const uint32_t*>(in.take(first[ntaxa+1] * 4));
+    names = in.p;
+    for(uint32_t i = in.u32(); i; i--) {
+	in.u32();
+	in.str();
+    }
+    if(!in.ok || in.p!=in.e) return;
+
+    if(std::memcmp(head, index_magic, sizeof index_magic)) return;
+    if(cache.map.size() < head_size) return;
+    ok = std::memcmp(head + 16, cache.map.begin() + 16, head_size - 16)==0;
+}
+
+
+/**
+ * Like Cache::fits().
+ */
+bool Index::fits(const Taxa& spp) const
+{
+    if(!ok) return false;
+    const md5::Digest d = ::digest(spp);
+    return std::memcmp(map.begin() + 32, d.val, 16)==0;
+}
+
+
+/**
+ * The excursions containing one or more of 'taxa', in order.
+ */
+std::vector<unsigned> Index::find(const std::vector<TaxonId>& taxa) const
+{
+    std::vector<unsigned> acc;
+    for(const TaxonId id : taxa) {
+	if(id.val > ntaxa) continue;
+	const uint32_t* const a = postings + first[id.val];
+	const uint32_t* const b = postings + first[id.val + 1];
+	const size_t n = acc.size();
+	acc.insert(acc.end(), a, b);
+	std::inplace_merge(acc.begin(), acc.begin() + n, acc.end());
+    }
+    acc.erase(std::unique(acc.begin(), acc.end()), acc.end());
+    return acc;
+}
+
+
+std::vector<Index::Invented> Index::invented() const
+{
+    std::vector<Invented> acc;
+    if(!ok) return acc;
+    Reader in(names, map.end());
+    for(uint32_t i = in.u32(); i; i--) {
+	const unsigned n = in.u32();
+	acc.push_back({n, in.str()});
+    }
+    return acc;
+}
@@ -0,0 +1,173 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_CACHE_H
+#define GROBLAD_CACHE_H
+
+#include "mmap.h"
+#include "md5pp.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+
+#include "taxon.h"
+
+class Taxa;
+class FieldList;
+class FieldView;
+class Index;
+class Replacement;
+
+/**
+ * The parsed form of a book: all excursions in it, and all
+ * diagnostics about it, as get() would have produced them.  It's kept
+ * as ".name.cache" next to the book, and is fresh() for as long as
+ * the MD5 digest of the book's text is the one it was made from.
+ * While the book keeps its size, inode and modification time, that
+ * is assumed rather than checked.
+ *
+ * Since get() augments the Taxa with unfamiliar taxa, and what it
+ * complains about depends on it, the cache also only fits() the same
+ * taxa as when it was made.  Reading it augments them the same way
+ * get() would have.
+ *
+ * A cache which isn't fresh may still be for the start of the book,
+ * if lines have been appended to it since.  Then it's still useful,
+ * for everything but the new lines.
+ *
+ * Only regular files named as such can have caches -- not standard
+ * input, even if there's a file named "-".  Trouble writing one just
+ * means there won't be a cache.  The Index is written along with it.
+ */
+class Cache {
+public:
+    explicit Cache(const std::string& book);
+
+    bool fresh();
+    bool appended();
+    size_t length() const;
+    unsigned lines() const;
+    bool fits(const Taxa& spp) const;
+    bool get(std::ostream& err, Taxa& spp, FieldList& ex);
+    bool get(std::ostream& err, Taxa& spp, FieldView& ex);
+
+    class Writer;
+
+private:
+    Cache(const Cache&);
+    Cache& operator= (const Cache&);
+
+    friend class Index;
+    bool hash();
+    template<class Ex>
+    bool next(std::ostream& err, Taxa& spp, Ex& ex);
+
+    const std::string book;
+    const std::string path;
+    bool hashed;
+    bool regular;
+    bool whole;
+    md5::Digest digest;
+    md5::Digest covered;
+    std::string stamp;
+    size_t book_length;
+    unsigned book_lines;
+    Mmap map;
+    const char* p;
+};
+
+
+/**
+ * Writing a new cache for a book, from the excursions and diagnostics
+ * get() produced from it.  It's only put in place by commit();
+ * otherwise it's discarded.
+ */
+class Cache::Writer {
+public:
+    Writer(Cache& cache, const Taxa& spp);
+    ~Writer();
+
+    void keep(const Cache& cache, const Index& index);
+    void add(const std::string& err, const FieldList& ex,
+	     size_t offset, unsigned line);
+    bool commit();
+
+private:
+    Writer(const Writer&);
+    Writer& operator= (const Writer&);
+
+    void diagnostics(const std::string& err);
+    void flush();
+    void write_index();
+
+    const std::string book;
+    const std::string path;
+    std::unique_ptr<Replacement> file;
+    std::string buf;
+    std::string head;
+
+    const unsigned known;
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> lines;
+    std::vector<std::vector<uint32_t>> postings;
+    std::vector<std::pair<unsigned, std::string>> invented;
+};
+
+
+/**
+ * Which excursions in a book contain which taxa: for each TaxonId,
+ * the numbers (counting from 0, in the order get() finds them) of
+ * the excursions with a sighting of it. And for each excursion,
+ * where get() can start reading the book to find it.
+ *
+ * It's kept as ".name.index" next to the book, and is written with
+ * its Cache. It's valid() if it's the one written with the cache;
+ * then it's fresh() and fits() when the cache is, and covers the
+ * same length() of the book.
+ * Taxa which get() invented aren't in it; taxa() is the highest
+ * TaxonId which is. Their names are, in the order get() invented
+ * them, and so are the excursions where that happened.
+ */
+class Index {
+public:
+    explicit Index(Cache& cache);
+
+    bool valid() const { return ok; }
+    bool fits(const Taxa& spp) const;
+
+    unsigned size() const { return n; }
+    unsigned taxa() const { return ntaxa; }
+    std::vector<unsigned> find(const std::vector<TaxonId>& taxa) const;
+    size_t offset(unsigned i) const { return offsets[i]; }
+    unsigned line(unsigned i) const { return lines[i]; }
+
+    /**
+     * A taxon get() invented, and the excursion where it did.
+     */
+    typedef std::pair<unsigned, std::string> Invented;
+    std::vector<Invented> invented() const;
+
+private:
+    Index(const Index&);
+    Index& operator= (const Index&);
+
+    friend class Cache::Writer;
+
+    Mmap map;
+    bool ok;
+    unsigned ntaxa;
+    unsigned n;
+    const uint64_t* offsets;
+    const uint32_t* lines;
+    const uint32_t* first;
+    const uint32_t* postings;
+    const char* names;
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "chunk.h"
+
+#include "lineparse.h"
+
+#include <sstream>
+
+
+/**
+ * Read whole lines from 'is' until there are at least 'size' octets
+ * and we're between excursions, or until end of input. Returns false
+ * if there was nothing left to read.
+ *
+ * A chunk also ends where a file ends between excursions, so that
+ * each file can be dealt with on its own (see Parser).
+ */
+bool Chunk::get(Files& is, const size_t size)
+{
+    using Parse::ws;
+    using Parse::trimr;
+
+    runs.clear();
+    maps.clear();
+    text.clear();
+
+    /* the same states and transitions as in get(Files&, ...) */
+    enum State { BETWEEN, HEADERS, SIGHTINGS };
+    State state = BETWEEN;
+    unsigned line = 0;
+    size_t octets = 0;
+    size_t origin;
+    const char* a;
+    const char* e;
+
+    while(origin = is.offset(), is.getline(a, e)) {
+
+	const Files::Position& pos = is.position();
+	if(runs.empty() || pos.line != line+1) {
+	    /* a first line is at the start of a file we just opened */
+	    if(pos.line==1) origin = 0;
+	    const std::shared_ptr<const Mmap> m = is.mapping();
+	    if(m && (maps.empty() || maps.back()!=m)) maps.push_back(m);
+	    const size_t at = m ? a - m->begin() : text.size();
+	    runs.push_back({pos, origin, m.get(), at, at});
+	}
+	line = pos.line;
+
+	Run& run = runs.back();
+	if(run.map) {
+	    /* with the newline, unless it's missing at the end */
+	    run.b = e - run.map->begin();
+	    if(run.b < run.map->size()) run.b++;
+	}
+	else {
+	    text.append(a, e);
+	    text.push_back('\n');
+	    run.b = text.size();
+	}
+	octets += e - a + 1;
+
+	const char* const b = trimr(a, e);
+	const char* const c = ws(a, b);
+	if(c==b || *c=='#') continue;
+
+	if(state==BETWEEN) {
+	    if(*a=='{' && a+1==b) state = HEADERS;
+	}
+	else if(state==HEADERS) {
+	    if(a+2==b && a[0]=='}' && a[1]=='{') state = SIGHTINGS;
+	}
+	else {
+	    if(a+1==b && *a=='}') state = BETWEEN;
+	}
+
+	if(state==BETWEEN &&
+	   (octets >= size || is.exhausted())) return true;
+    }
+
+    if(runs.empty()) return false;
+
+    /* An empty last segment, so that get() sees the same position
+     * at end of input as it would have.
+     */
+    runs.push_back({is.position(), is.offset(), 0,
+		    text.size(), text.size()});
+    return true;
+}
+
+
+/**
+ * The lines, for reading using Files.
+ */
+std::vector<Files::Segment> Chunk::segments() const
+{
+    std::vector<Files::Segment> acc;
+    for(const Run& run : runs) {
+	const char* const p = run.map ? run.map->begin() : text.data();
+	acc.push_back({run.pos, p + run.a, p + run.b, run.origin});
+    }
+    return acc;
+}
+
+
+namespace {
+
+    template<class Spp>
+    void parse(Parsed& parsed, const Chunk& chunk, Spp& spp)
+    {
+	parsed.items.clear();
+
+	const std::vector<Files::Segment> segs = chunk.segments();
+	Files is(segs);
+	std::ostringstream err;
+	Excursion ex;
+	/* where get() starts reading */
+	size_t offset = segs.empty() ? 0 : segs.front().offset;
+	unsigned line = segs.empty() ? 0 : segs.front().pos.line;
+	while(get(is, err, spp, ex)) {
+	    parsed.items.push_back(Parsed::Item());
+	    Parsed::Item& item = parsed.items.back();
+	    item.err = err.str();
+	    item.ex.swap(ex);
+	    item.offset = offset;
+	    item.line = line;
+	    err.str("");
+	    offset = is.offset();
+	    line = is.position().line + 1;
+	}
+	parsed.err = err.str();
+    }
+}
+
+
+void Parsed::parse(const Chunk& chunk, Taxa& spp)
+{
+    ::parse(*this, chunk, spp);
+}
+
+
+/**
+ * Parse with a read-only 'spp'. Throws Unfamiliar if the chunk
+ * needs a taxon which isn't there.
+ */
+void Parsed::parse(const Chunk& chunk, const Taxa& spp)
+{
+    ::parse(*this, chunk, spp);
+}
@@ -0,0 +1,73 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_CHUNK_H
+#define GROBLAD_CHUNK_H
+
+#include "files...h"
+#include "excursion.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+
+/**
+ * A run of lines from a Files, cut where get() would be between
+ * excursions. Thus it can be parsed on its own, yet with the same
+ * result and the same diagnostics as when parsing the whole thing
+ * line by line.
+ *
+ * Lines from a mapped file are left where they are, and the mapping
+ * is kept alive for as long as the Chunk is. Only lines which Files
+ * had to read(2) are copied.
+ *
+ * It may span files, if it happens to end up in the middle of an
+ * excursion at the end of one (which is an error, but not one
+ * which changes how the rest is parsed).
+ */
+class Chunk {
+public:
+    bool get(Files& is, size_t size);
+    bool empty() const { return runs.empty(); }
+
+    std::vector<Files::Segment> segments() const;
+
+private:
+    /* [a, b) in 'map', or in 'text' if there's no map */
+    struct Run {
+	Files::Position pos;
+	size_t origin;
+	const Mmap* map;
+	size_t a;
+	size_t b;
+    };
+
+    std::vector<Run> runs;
+    std::vector<std::shared_ptr<const Mmap>> maps;
+    std::string text;
+};
+
+
+/**
+ * The result of running get() over a Chunk: the excursions, and
+ * the diagnostics logged before each was complete, and after the
+ * last one.
+ */
+struct Parsed {
+    struct Item {
+	std::string err;
+	Excursion ex;
+	size_t offset;
+	unsigned line;
+    };
+    std::vector<Item> items;
+    std::string err;
+
+    void parse(const Chunk& chunk, Taxa& spp);
+    void parse(const Chunk& chunk, const Taxa& spp);
+};
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * $Id: contstream.cc,v 1.8 2008-01-03 12:51:38 grahn Exp $
  *
- * Copyright (c) 2006, 2008 Jrgen Grahn
+ * Copyright (c) 2006, 2008 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -4,7 +4,7 @@
  *
  * contstream.h
  *
- * Copyright (c) 2006, 2008 Jrgen Grahn
+ * Copyright (c) 2006, 2008 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "cooccurrence.h"
+
+#include "book.h"
+
+#include <algorithm>
+
+
+/**
+ * Index 'book', whose TaxonIds are all less than 'taxa'.
+ */
+Cooccurrence::Cooccurrence(const Book& book, const size_t taxa)
+    : book(book),
+      n(book.size()),
+      excursions(taxa),
+      column(taxa),
+      words((n + 63) / 64)
+{
+    for(unsigned i = 0; i < n; i++) {
+	const Book::Entry ex = book[i];
+	for(auto j = ex.tbegin(); j != ex.tend(); j++) {
+	    excursions[j->val].push_back(i);
+	}
+    }
+
+    for(size_t i = 0; i < taxa; i++) {
+	const std::vector<unsigned>& v = excursions[i];
+	if(v.empty() || 16 * v.size() < n) continue;
+	dense_taxa.push_back(TaxonId(i));
+	column[i] = dense_taxa.size();
+    }
+
+    bits.resize(dense_taxa.size() * words);
+    for(const TaxonId sp : dense_taxa) {
+	uint64_t* const p = &bits[(column[sp.val] - 1) * words];
+	for(const unsigned e : excursions[sp.val]) {
+	    p[e / 64] |= uint64_t(1) << e % 64;
+	}
+    }
+}
+
+
+/**
+ * The taxa seen together with 'sp', and in how many excursions, into
+ * 'acc': the most common first, and otherwise in TaxonId order.
+ * 'scratch' is working space, all zeros, which is left that way.
+ */
+void Cooccurrence::row(const TaxonId sp, std::vector<unsigned>& scratch,
+		       std::vector<Pair>& acc) const
+{
+    acc.clear();
+    if(scratch.size() < excursions.size()) scratch.resize(excursions.size());
+    const bool d = dense(sp);
+
+    for(const unsigned e : excursions[sp.val]) {
+	const Book::Entry ex = book[e];
+	for(auto i = ex.tbegin(); i != ex.tend(); i++) {
+	    if(*i==sp || (d && dense(*i))) continue;
+	    if(!scratch[i->val]++) acc.push_back({*i, 0});
+	}
+    }
+    for(Pair& p : acc) {
+	p.n = scratch[p.sp.val];
+	scratch[p.sp.val] = 0;
+    }
+
+    if(d) {
+	for(const TaxonId other : dense_taxa) {
+	    if(other==sp) continue;
+	    const unsigned k = common(sp, other);
+	    if(k) acc.push_back({other, k});
+	}
+    }
+
+    std::sort(acc.begin(), acc.end(),
+	      [] (const Pair& a, const Pair& b) {
+		  if(a.n != b.n) return a.n > b.n;
+		  return a.sp < b.sp;
+	      });
+}
+
+
+/**
+ * Helper. The number of excursions with both of the dense taxa 'a'
+ * and 'b' in them.
+ */
+unsigned Cooccurrence::common(const TaxonId a, const TaxonId b) const
+{
+    const uint64_t* p = &bits[(column[a.val] - 1) * words];
+    const uint64_t* q = &bits[(column[b.val] - 1) * words];
+    unsigned k = 0;
+    for(size_t i = 0; i < words; i++) {
+	k += __builtin_popcountll(p[i] & q[i]);
+    }
+    return k;
+}
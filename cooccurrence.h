@@ -0,0 +1,60 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_COOCCURRENCE_H
+#define GROBLAD_COOCCURRENCE_H
+
+#include "taxon.h"
+
+#include <vector>
+#include <cstdint>
+
+class Book;
+
+/**
+ * Which taxa are seen together with which, in the excursions of a
+ * Book, and how often.
+ *
+ * For each taxon, the excursions it's in are listed.  Common taxa --
+ * in at least one excursion in sixteen -- also get a bitset over the
+ * excursions, and two of those are counted together with AND and
+ * popcount.  All other pairs are counted by visiting the excursions
+ * of the taxon in question.  Nothing is kept per pair of taxa, so
+ * memory use doesn't grow with the square of the species list.
+ *
+ * row() doesn't modify the Cooccurrence; several threads can ask
+ * for rows at the same time.
+ */
+class Cooccurrence {
+public:
+    Cooccurrence(const Book& book, size_t taxa);
+
+    struct Pair {
+	TaxonId sp;
+	unsigned n;
+    };
+
+    unsigned size() const { return n; }
+    unsigned count(TaxonId sp) const { return excursions[sp.val].size(); }
+    void row(TaxonId sp, std::vector<unsigned>& scratch,
+	     std::vector<Pair>& acc) const;
+
+private:
+    Cooccurrence(const Cooccurrence&);
+    Cooccurrence& operator= (const Cooccurrence&);
+
+    bool dense(TaxonId sp) const { return column[sp.val]; }
+    unsigned common(TaxonId a, TaxonId b) const;
+
+    const Book& book;
+    const unsigned n;
+    std::vector<std::vector<unsigned>> excursions;
+    std::vector<unsigned> column;
+    std::vector<TaxonId> dense_taxa;
+    std::vector<uint64_t> bits;
+    size_t words;
+};
+
+#endif
@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2013, 2014 Jrgen Grahn
+ * Copyright (c) 2013, 2014 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -37,6 +37,7 @@
  */
 class Coordinate {
 public:
+    Coordinate() : north(0), east(0), resolution(0) {}
     Coordinate(const char* a, const char* b);
     bool valid() const { return north; }
     bool rt90() const { return north && east > 1000000; }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013 Jrgen Grahn
+ * Copyright (c) 2013 Jörgen Grahn
  * All rights reserved.
  *
  */
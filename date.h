@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2013 Jrgen Grahn
+ * Copyright (c) 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -54,6 +54,10 @@ class Date {
 public:
     Date() : val(0) {}
     Date(const char* a, const char* b);
+    Date(unsigned val, const std::string& trailer)
+	: val(val),
+	  trailer(trailer)
+    {}
     bool operator< (const Date& other) const {
 	if(val != other.val) return val<other.val;
 	return trailer < other.trailer;
@@ -63,6 +67,10 @@ public:
     struct tm tm() const;
     std::ostream& put(std::ostream& os) const;
 
+    /* the parsed form, e.g. for storing it */
+    unsigned value() const { return val; }
+    const std::string& rest() const { return trailer; }
+
 private:
     unsigned val;
     std::string trailer;
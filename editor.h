@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (C) 2013 Jrgen Grahn
+ * Copyright (C) 2013 Jörgen Grahn
  * All rights reserved.
  */
 #ifndef GAVIA_EDITOR_H
@@ -1,4 +1,4 @@
-/* Copyright (c) 1999, 2008, 2011, 2013 Jrgen Grahn
+/* Copyright (c) 1999, 2008, 2011, 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -24,43 +24,24 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "excursion.h"
+#include "fieldview.h"
 #include "taxa.h"
+#include "taxonset.h"
 
 #include "lineparse.h"
 #include "files...h"
 
 #include <algorithm>
-#include <array>
+#include <cstring>
 
 
-namespace {
-
-    bool known_header(const std::string& name)
-    {
-	static const std::array<const char*, 6> names {
-	    "place",
-	    "coordinate",
-	    "date",
-	    "observers",
-	    "comments",
-	    "status",
-	};
-	auto it = std::find(begin(names), end(names), name);
-	return it != end(names);
-    }
-
-    bool important_header(const std::string& name)
-    {
-	static const std::array<const char*, 4> names {
-	    "place",
-	    "coordinate",
-	    "date",
-	    "observers",
-	};
-	auto it = std::find(begin(names), end(names), name);
-	return it != end(names);
-    }
-}
+static_assert(header::known("place", 5)==header::PLACE, "");
+static_assert(header::known("coordinate", 10)==header::COORDINATE, "");
+static_assert(header::known("date", 4)==header::DATE, "");
+static_assert(header::known("observers", 9)==header::OBSERVERS, "");
+static_assert(header::known("comments", 8)==header::COMMENTS, "");
+static_assert(header::known("status", 6)==header::STATUS, "");
+static_assert(header::known("plaice", 6)==header::OTHER, "");
 
 
 void Excursion::swap(Excursion& other)
@@ -69,6 +50,8 @@ void Excursion::swap(Excursion& other)
     sightings.swap(other.sightings);
     std::swap(date, other.date);
     std::swap(place, other.place);
+    std::swap(coordinate, other.coordinate);
+    std::swap(slots, other.slots);
 }
 
 
@@ -79,11 +62,13 @@ void Excursion::swap(Excursion& other)
 bool Excursion::add_header(const char* a, size_t alen,
 			   const char* b, size_t blen)
 {
+    const header::Known k = header::known(a, alen);
     const std::string name{a, alen};
-    const bool was_present = has_header(name);
+    const bool was_present = k==header::OTHER ? has_header(name)
+					      : slots[k];
 
-    const Header h(name, std::string(b, blen));
-    headers.push_back(h);
+    headers.emplace_back(name, std::string(b, blen));
+    if(k!=header::OTHER && !was_present) slots[k] = headers.size();
     return !was_present;
 }
 
@@ -110,19 +95,45 @@ bool Excursion::add_sighting(Taxa& spp,
 			     const char* a, size_t alen,
 			     const char* b, size_t blen)
 {
-    const std::string name(a, alen);
-    TaxonId id = spp.find(name);
+    TaxonId id = spp.find(a, alen);
     const bool familiar = id;
     if(!familiar) {
-	id = spp.insert(name);
+	id = spp.insert(std::string(a, alen));
     }
 
-    sightings.push_back(Sighting(id, name,
-				 std::string(b, blen)));
+    sightings.emplace_back(id, a, alen, b, blen);
     return familiar;
 }
 
 
+/**
+ * Like add_sighting(Taxa&, ...), but throws Unfamiliar instead of
+ * inventing a taxon.
+ */
+bool Excursion::add_sighting(const Taxa& spp,
+			     const char* a, size_t alen,
+			     const char* b, size_t blen)
+{
+    const TaxonId id = spp.find(a, alen);
+    if(!id) throw Unfamiliar();
+
+    sightings.emplace_back(id, a, alen, b, blen);
+    return true;
+}
+
+
+/**
+ * Add a sighting of a taxon which has already been looked up,
+ * e.g. when reading back an excursion stored by a Cache.
+ */
+void Excursion::add_sighting(TaxonId sp,
+			     const char* a, size_t alen,
+			     const char* b, size_t blen)
+{
+    sightings.emplace_back(sp, a, alen, b, blen);
+}
+
+
 bool Excursion::add_sighting_cont(const char* a, size_t alen)
 {
     if(sightings.empty()) return false;
@@ -139,10 +150,21 @@ bool Excursion::add_sighting_cont(const char* a, size_t alen)
  */
 bool Excursion::finalize()
 {
-    const std::string& s = find_header("date");
+    const std::string& s = header(header::DATE);
     const char* a = s.c_str();
-    date = Date(a, a+s.size());
-    place = find_header("place");
+    return finalize(Date(a, a+s.size()));
+}
+
+
+/**
+ * Like finalize(), for a 'date' which has already been parsed.
+ */
+bool Excursion::finalize(const Date& date)
+{
+    this->date = date;
+    place = header(header::PLACE);
+    const std::string& s = header(header::COORDINATE);
+    coordinate = Coordinate(s.data(), s.data() + s.size());
     return true;
 }
 
@@ -176,8 +198,22 @@ bool Excursion::has_one(const std::vector<TaxonId>& taxa) const
 }
 
 
+/**
+ * Like has_one() above, but faster when there are many taxa.
+ */
+bool Excursion::has_one(const TaxonSet& taxa) const
+{
+    return std::any_of(sightings.begin(), sightings.end(),
+		       [&taxa] (const Sighting& s) {
+			   return taxa.contains(s.sp);
+		       });
+}
+
+
 bool Excursion::has_header(const std::string& name) const
 {
+    const header::Known k = header::known(name.data(), name.size());
+    if(k!=header::OTHER) return slots[k];
     auto i = std::find_if(begin(headers), end(headers),
 			  [name] (const Header& h) { return h.name==name; });
     return i != end(headers);
@@ -191,6 +227,8 @@ bool Excursion::has_header(const std::string& name) const
 const std::string& Excursion::find_header(const char* name) const
 {
     static const std::string NIL;
+    const header::Known k = header::known(name, std::strlen(name));
+    if(k!=header::OTHER) return header(k);
     auto i = std::find_if(begin(headers), end(headers),
 			  [name] (const Header& h) {
 			      return h.name==name;
@@ -200,6 +238,17 @@ const std::string& Excursion::find_header(const char* name) const
 }
 
 
+/**
+ * The value of the first 'name' header, or "".
+ */
+const std::string& Excursion::header(const header::Known name) const
+{
+    static const std::string NIL;
+    const unsigned n = slots[name];
+    return n ? headers[n-1].value : NIL;
+}
+
+
 namespace {
 
     struct Errlog {
@@ -209,9 +258,9 @@ namespace {
 	      files(files)
 	{}
 
-	void general(const std::string& s);
-	void header(const std::string& s) { general(s); }
-	void sighting(const std::string& s) { general(s); }
+	void general(const char* a, const char* b);
+	void header(const char* a, const char* b) { general(a, b); }
+	void sighting(const char* a, const char* b) { general(a, b); }
 	void trailer();
 
 	void warn_dup_header(const std::string&);
@@ -222,9 +271,10 @@ namespace {
 	const Files& files;
     };
 
-    void Errlog::general(const std::string& s)
+    void Errlog::general(const char* a, const char* b)
     {
-	errstream << files.position() << ": parse error: " << s << '\n';
+	errstream << files.position() << ": parse error: ";
+	errstream.write(a, b-a) << '\n';
     }
 
     void Errlog::trailer()
@@ -252,140 +302,196 @@ namespace {
 }
 
 
-/**
- * Read one excursion from 'is', using and possibly augmenting 'spp'
- * meanwhile.  Logs errors (warnings, really) to 'err'.
- * Returns false at eof with no complete excursion read.
- */
-bool get(Files& is, std::ostream& errstream,
-	 Taxa& spp, Excursion& excursion)
-{
-    using Parse::ws;
-    using Parse::trimr;
+namespace {
 
-    Errlog err(errstream, is);
+    /**
+     * The body of get(), for a 'spp' which is either a Taxa or a
+     * read-only one, and an Excursion or a FieldView.
+     */
+    template<class Spp, class Ex>
+    bool get_excursion(Files& is, std::ostream& errstream,
+		       Spp& spp, Ex& excursion)
+    {
+	using Parse::ws;
+	using Parse::trimr;
+	using Parse::find;
 
-    enum State { BETWEEN, HEADERS, SIGHTINGS };
-    State state = BETWEEN;
-    Excursion ex;
-    std::string s;
+	Errlog err(errstream, is);
 
-    while(is.getline(s)) {
+	enum State { BETWEEN, HEADERS, SIGHTINGS };
+	State state = BETWEEN;
+	Ex ex;
+	const char* a;
+	const char* e;
 
-	const char* a = s.c_str();
-	const char* const b = trimr(a, a + s.size());
+	while(is.getline(a, e)) {
 
-	const char* c = ws(a, b);
-	if(c==b || *c=='#') continue;
+	    const char* const b = trimr(a, e);
 
-	if(state==BETWEEN) {
+	    const char* c = ws(a, b);
+	    if(c==b || *c=='#') continue;
 
-	    if(*a=='{' && a+1==b) {
-		state = HEADERS;
-	    }
-	    else {
-		err.general(s);
-		continue;
+	    if(state==BETWEEN) {
+
+		if(*a=='{' && a+1==b) {
+		    state = HEADERS;
+		}
+		else {
+		    err.general(a, e);
+		    continue;
+		}
 	    }
-	}
-	else if(state==HEADERS && c==a) {
+	    else if(state==HEADERS && c==a) {
+
+		if(a+2==b && a[0]=='}' && a[1]=='{') {
+		    check_last_header(ex, is, errstream);
+		    state = SIGHTINGS;
+		    continue;
+		}
+
+		c = find(a, b, ':');
+		if(c==b) {
+		    err.header(a, e);
+		    continue;
+		}
+
+		const char* d = trimr(a, c);
+		c = ws(c+1, b);
 
-	    if(a+2==b && a[0]=='}' && a[1]=='{') {
 		check_last_header(ex, is, errstream);
-		state = SIGHTINGS;
-		continue;
+
+		/* [a, d) : [c, b) */
+		const header::Known k = header::known(a, d-a);
+		if(!ex.add_header(a, d-a, c, b-c)) {
+		    if(k!=header::OTHER) {
+			err.warn_dup_header(header::names[k]);
+		    }
+		}
+		if(b==c && header::important(k)) {
+		    err.warn_empty_header(header::names[k]);
+		}
 	    }
+	    else if(state==HEADERS) {
 
-	    c = std::find(a, b, ':');
-	    if(c==b) {
-		err.header(s);
-		continue;
+		/* continuation ___ [c, b) */
+		if(!ex.add_header_cont(c, b-c)) {
+		    err.header(a, e);
+		}
 	    }
+	    else if(state==SIGHTINGS && c==a) {
+
+		if(a+1==b && *a=='}') {
+		    check_last_sighting(ex, is, errstream);
+		    check_sightings(ex, spp, is, errstream);
+		    ex.finalize();
+		    ex.swap(excursion);
+		    return true;
+		}
 
-	    const char* d = trimr(a, c);
-	    c = ws(c+1, b);
+		/* species : marker : comment
+		 * a       c        d        b
+		 */
+		c = find(a, b, ':');
+		if(c==b) {
+		    err.sighting(a, e);
+		    continue;
+		}
 
-	    check_last_header(ex, is, errstream);
+		/* The common "species : :" from the template, unfilled.
+		 * Since [a, b) is trimmed, the second colon is last.
+		 */
+		if(b-c > 1 && b[-1]==':' &&
+		   ws(c+1, b-1)==b-1 && trimr(a, c)!=a) {
+		    continue;
+		}
 
-	    /* [a, d) : [c, b) */
-	    const std::string name(a, d-a);
-	    if(!ex.add_header(a, d-a, c, b-c)) {
-		if(known_header(name)) {
-		    err.warn_dup_header(name);
+		const char* d = find(c+1, b, ':');
+		if(d==b) {
+		    err.sighting(a, e);
+		    continue;
 		}
-	    }
-	    if(b==c && important_header(name)) {
-		err.warn_empty_header(name);
-	    }
-	}
-	else if(state==HEADERS) {
 
-	    /* continuation ___ [c, b) */
-	    if(!ex.add_header_cont(c, b-c)) {
-		err.header(s);
-	    }
-	}
-	else if(state==SIGHTINGS && c==a) {
+		/* species : marker : comment
+		 * a      .  c     .  d      b
+		 */
+		const char* ae = trimr(a, c);
+		c = ws(c+1, b);
+		const char* ce = trimr(c, d);
+		d = ws(d+1, b);
+		const char* de = trimr(d, b);
+		if(a==ae) {
+		    err.sighting(a, e);
+		    continue;
+		}
+		if(c==ce && d==de) {
+		    /* unfilled */
+		    continue;
+		}
 
-	    if(a+1==b && *a=='}') {
 		check_last_sighting(ex, is, errstream);
-		check_sightings(ex, spp, is, errstream);
-		ex.finalize();
-		ex.swap(excursion);
-		return true;
-	    }
 
-	    /* species : marker : comment
-	     * a       c        d        b
-	     */
-	    c = std::find(a, b, ':');
-	    if(c==b) {
-		err.sighting(s);
-		continue;
-	    }
-	    const char* d = std::find(c+1, b, ':');
-	    if(d==b) {
-		err.sighting(s);
-		continue;
-	    }
-
-	    /* species : marker : comment
-	     * a      .  c     .  d      b
-	     */
-	    const char* ae = trimr(a, c);
-	    c = ws(c+1, b);
-	    const char* ce = trimr(c, d);
-	    d = ws(d+1, b);
-	    const char* de = trimr(d, b);
-	    if(a==ae) {
-		err.sighting(s);
-		continue;
-	    }
-	    if(c==ce && d==de) {
-		/* unfilled */
-		continue;
+		/* [a, ae) : marker : [d, de) */
+		if(!ex.add_sighting(spp,
+				    a, ae-a,
+				    d, de-d)) {
+		    err.warn_sighting(a, ae-a);
+		}
 	    }
+	    else if(state==SIGHTINGS) {
 
-	    check_last_sighting(ex, is, errstream);
-
-	    /* [a, ae) : marker : [d, de) */
-	    if(!ex.add_sighting(spp,
-				a, ae-a,
-				d, de-d)) {
-		err.warn_sighting(a, ae-a);
+		/* continuation ___ [c, b) */
+		if(!ex.add_sighting_cont(c, b-c)) {
+		    err.sighting(a, e);
+		}
 	    }
 	}
-	else if(state==SIGHTINGS) {
 
-	    /* continuation ___ [c, b) */
-	    if(!ex.add_sighting_cont(c, b-c)) {
-		err.sighting(s);
-	    }
+	if(state!=BETWEEN) {
+	    err.trailer();
 	}
+	return false;
     }
+}
 
-    if(state!=BETWEEN) {
-	err.trailer();
-    }
-    return false;
+
+/**
+ * Read one excursion from 'is', using and possibly augmenting 'spp'
+ * meanwhile.  Logs errors (warnings, really) to 'err'.
+ * Returns false at eof with no complete excursion read.
+ */
+bool get(Files& is, std::ostream& errstream,
+	 Taxa& spp, Excursion& excursion)
+{
+    return get_excursion(is, errstream, spp, excursion);
+}
+
+
+/**
+ * Like get() above, but with a read-only 'spp'. Throws Unfamiliar
+ * on a sighting of a taxon not in it, so a thread can parse from
+ * a Taxa which others are reading at the same time.
+ */
+bool get(Files& is, std::ostream& errstream,
+	 const Taxa& spp, Excursion& excursion)
+{
+    return get_excursion(is, errstream, spp, excursion);
+}
+
+
+/**
+ * Like get() above, but for a view of the excursion.  This only
+ * works if the lines 'is' reads stay where they are, i.e. if it
+ * reads Files::Segments.
+ */
+bool get(Files& is, std::ostream& errstream,
+	 Taxa& spp, FieldView& excursion)
+{
+    return get_excursion(is, errstream, spp, excursion);
+}
+
+
+bool get(Files& is, std::ostream& errstream,
+	 const Taxa& spp, FieldView& excursion)
+{
+    return get_excursion(is, errstream, spp, excursion);
 }
@@ -1,6 +1,6 @@
 /*----------------------------------------------------------------------------
  *
- * Copyright (c) 1999, 2000, 2008, 2013 Jrgen Grahn
+ * Copyright (c) 1999, 2000, 2008, 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -30,15 +30,66 @@
 
 #include "taxon.h"
 #include "date.h"
+#include "coordinate.h"
 
 #include <string>
 #include <vector>
+#include <array>
 #include <iostream>
 #include <cstdio>
 
 
 class Taxa;
 class Files;
+class TaxonSet;
+
+/**
+ * The header fields groblad(5) defines.  An excursion remembers
+ * where the first one of each is, so it can be found without
+ * searching and comparing names.
+ */
+namespace header {
+
+    enum Known { PLACE, COORDINATE, DATE, OBSERVERS, COMMENTS, STATUS,
+		 OTHER };
+
+    constexpr const char* names[] = { "place", "coordinate", "date",
+				      "observers", "comments", "status" };
+
+    /* The names have different lengths, so the length is a perfect
+     * hash.  If that changes, the static_asserts in excursion.cc
+     * will say so.
+     */
+    constexpr Known by_length[] = { OTHER, OTHER, OTHER, OTHER,
+				    DATE, PLACE, STATUS, OTHER,
+				    COMMENTS, OBSERVERS, COORDINATE };
+
+    constexpr bool same(const char* a, const char* b, size_t n)
+    {
+	return !n || (*a==*b && same(a+1, b+1, n-1));
+    }
+
+    constexpr Known candidate(size_t n)
+    {
+	return n < sizeof by_length / sizeof by_length[0] ? by_length[n]
+							  : OTHER;
+    }
+
+    /**
+     * Which header [s, s+n) names, if any.
+     */
+    constexpr Known known(const char* s, size_t n)
+    {
+	return candidate(n)!=OTHER && same(s, names[candidate(n)], n)
+	    ? candidate(n)
+	    : OTHER;
+    }
+
+    /**
+     * True for the headers which are expected to have a value.
+     */
+    constexpr bool important(Known k) { return k <= OBSERVERS; }
+}
 
 /**
  * A field list, or excursion, as it appears in a groblad(5) file but
@@ -78,6 +129,13 @@ public:
 	      name(name),
 	      comment(comment)
 	{}
+	Sighting(TaxonId sp,
+		 const char* a, size_t alen,
+		 const char* b, size_t blen)
+	    : sp(sp),
+	      name(a, alen),
+	      comment(b, blen)
+	{}
 	TaxonId sp;
 	std::string name;
 	std::string comment;
@@ -95,11 +153,19 @@ public:
     bool add_sighting(Taxa& spp,
 		      const char* a, size_t alen,
 		      const char* b, size_t blen);
+    bool add_sighting(const Taxa& spp,
+		      const char* a, size_t alen,
+		      const char* b, size_t blen);
+    void add_sighting(TaxonId sp,
+		      const char* a, size_t alen,
+		      const char* b, size_t blen);
     bool add_sighting_cont(const char* a, size_t alen);
     bool finalize();
+    bool finalize(const Date& date);
 
     bool operator< (const FieldList& other) const { return date < other.date; }
     bool has_one(const std::vector<TaxonId>& taxa) const;
+    bool has_one(const TaxonSet& taxa) const;
     bool contains(TaxonId taxon) const;
 
     std::ostream& put(std::ostream& os,
@@ -115,20 +181,30 @@ public:
 
     bool has_header(const std::string& name) const;
     const std::string& find_header(const char* name) const;
+    const std::string& header(header::Known name) const;
 
     Date date;
     std::string place;
+    Coordinate coordinate;
 
 private:
     Headers headers;
     Sightings sightings;
+    std::array<unsigned, header::OTHER> slots = {{}};
 };
 
 /* compatibility name */
 using Excursion = FieldList;
 
 
-void check_sightings(const Excursion& ex, Taxa& taxa,
+/**
+ * Thrown when a sighting names a taxon which isn't in a read-only
+ * Taxa, i.e. one which can't be augmented with it.
+ */
+struct Unfamiliar {};
+
+
+void check_sightings(const Excursion& ex, const Taxa& taxa,
 		     const Files& is, std::ostream& err);
 void check_last_header(const Excursion& ex,
 		       const Files& is, std::ostream& err);
@@ -137,6 +213,8 @@ void check_last_sighting(const Excursion& ex,
 
 bool get(Files& is, std::ostream& errstream,
 	 Taxa& spp, Excursion& excursion);
+bool get(Files& is, std::ostream& errstream,
+	 const Taxa& spp, Excursion& excursion);
 
 inline
 std::ostream& operator<< (std::ostream& os, const Excursion& val)
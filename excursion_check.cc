@@ -1,4 +1,4 @@
-/* Copyright (c) 2013, 2020 Jrgen Grahn
+/* Copyright (c) 2013, 2020 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -24,6 +24,7 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "excursion.h"
+#include "fieldview.h"
 #include "taxa.h"
 #include "files...h"
 #include "date.h"
@@ -46,57 +47,91 @@
 namespace {
 
     struct taxon_of {
-	TaxonId operator() (const Excursion::Sighting& val) const {
+	template<class Sighting>
+	TaxonId operator() (const Sighting& val) const {
 	    return val.sp;
 	}
     };
-}
 
+    const std::string& text(const std::string& s) { return s; }
+    std::string text(const FieldView::Text& s) { return s.str(); }
+
+    template<class Ex>
+    void sightings(const Ex& ex, const Taxa& taxa,
+		   const Files& is, std::ostream& err)
+    {
+	std::vector<TaxonId> spp(std::distance(ex.sbegin(), ex.send()));
+	std::transform(ex.sbegin(), ex.send(), begin(spp), taxon_of());
+
+	const std::vector<TaxonId>::const_iterator end = spp.end();
+	std::vector<TaxonId>::const_iterator i = begin(spp);
+	while((i = std::adjacent_find(i, end)) != end) {
+	    const Taxon taxon = taxa[*i];
+	    if (!taxon.genus) {
+		err << is.position() << ": duplicate entries for taxon \""
+		    << taxa[*i].name << "\"\n";
+	    }
+	    i++;
+	}
+    }
 
-void check_sightings(const Excursion& ex, Taxa& taxa,
+    template<class Ex>
+    void last_header(const Ex& ex,
 		     const Files& is, std::ostream& err)
-{
-    std::vector<TaxonId> spp(std::distance(ex.sbegin(), ex.send()));
-    std::transform(ex.sbegin(), ex.send(), begin(spp), taxon_of());
-
-    const std::vector<TaxonId>::const_iterator end = spp.end();
-    std::vector<TaxonId>::const_iterator i = begin(spp);
-    while((i = std::adjacent_find(i, end)) != end) {
-	const Taxon taxon = taxa[*i];
-	if (!taxon.genus) {
-	    err << is.position() << ": duplicate entries for taxon \""
-		<< taxa[*i].name << "\"\n";
+    {
+	if(ex.hbegin()==ex.hend()) return;
+	const auto& h = *(ex.hend()-1);
+
+	if(h.empty()) return;
+
+	/* A few headers aren't really free-form. */
+	if(h.name == "coordinate") {
+	    const std::string& value = text(h.value);
+	    const char* const s = value.c_str();
+	    const Coordinate coord(s, s + value.size());
+	    if(!coord.valid()) {
+		err << is.prev_position()
+		    << ": malformed coordinate \"" << value << "\"\n";
+	    }
+	}
+	else if(h.name == "date") {
+	    const std::string& value = text(h.value);
+	    const char* const s = value.c_str();
+	    const Date date(s, s + value.size());
+	    if(!date.valid()) {
+		err << is.prev_position()
+		    << ": malformed date \"" << value << "\"\n";
+	    }
 	}
-	i++;
     }
 }
 
 
+void check_sightings(const Excursion& ex, const Taxa& taxa,
+		     const Files& is, std::ostream& err)
+{
+    sightings(ex, taxa, is, err);
+}
+
+
+void check_sightings(const FieldView& ex, const Taxa& taxa,
+		     const Files& is, std::ostream& err)
+{
+    sightings(ex, taxa, is, err);
+}
+
+
 void check_last_header(const Excursion& ex,
 		       const Files& is, std::ostream& err)
 {
-    if(ex.hbegin()==ex.hend()) return;
-    const Excursion::Header& h = *(ex.hend()-1);
-
-    if(h.empty()) return;
-
-    /* A few headers aren't really free-form. */
-    if(h.name == "coordinate") {
-	const char* const s = h.value.c_str();
-	const Coordinate coord(s, s + h.value.size());
-	if(!coord.valid()) {
-	    err << is.prev_position()
-		<< ": malformed coordinate \"" << h.value << "\"\n";
-	}
-    }
-    else if(h.name == "date") {
-	const char* const s = h.value.c_str();
-	const Date date(s, s + h.value.size());
-	if(!date.valid()) {
-	    err << is.prev_position()
-		<< ": malformed date \"" << h.value << "\"\n";
-	}
-    }
+    last_header(ex, is, err);
+}
+
+
+void check_last_header(const FieldView& ex,
+		       const Files& is, std::ostream& err)
+{
+    last_header(ex, is, err);
 }
 
 
@@ -107,3 +142,8 @@ void check_last_sighting(const Excursion&,
      * been checked, and there's no point in restricting the comment.
      */
 }
+
+
+void check_last_sighting(const FieldView&,
+			 const Files&, std::ostream&)
+{}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "fieldview.h"
+
+#include "taxa.h"
+#include "taxonset.h"
+#include "lineparse.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+
+
+std::string FieldView::Text::str() const
+{
+    std::string s;
+    append_to(s);
+    return s;
+}
+
+
+/**
+ * Append the text to 's', with any continuation lines joined like
+ * FieldList does it: with a newline between them.  The other lines
+ * in the span aren't indented, or they're blank or comments.
+ */
+void FieldView::Text::append_to(std::string& s) const
+{
+    s.append(a, n);
+    const char* p = a + n;
+    const char* const e = a + span;
+    while(p!=e) {
+	const char* nl = static_cast<const char*>(std::memchr(p, '\n', e - p));
+	if(!nl) break;
+	const char* const l = nl + 1;
+	const char* b = Parse::find(l, e, '\n');
+	p = b;
+	b = Parse::trimr(l, b);
+	const char* const c = Parse::ws(l, b);
+	if(c==l || c==b || *c=='#') continue;
+
+	s += '\n';
+	s.append(c, b - c);
+	p = b;
+    }
+}
+
+
+bool FieldView::Text::operator== (const char* s) const
+{
+    if(!simple()) return str()==s;
+    return std::strlen(s)==n && std::memcmp(a, s, n)==0;
+}
+
+
+std::ostream& operator<< (std::ostream& os, const FieldView::Text& val)
+{
+    if(val.simple()) return os.write(val.a, val.n);
+    return os << val.str();
+}
+
+
+void FieldView::swap(FieldView& other)
+{
+    headers.swap(other.headers);
+    sightings.swap(other.sightings);
+    std::swap(date, other.date);
+    std::swap(place, other.place);
+    std::swap(coordinate, other.coordinate);
+    std::swap(slots, other.slots);
+}
+
+
+/**
+ * Make this a view of 'ex', as it is now.
+ */
+void FieldView::assign(const FieldList& ex)
+{
+    headers.clear();
+    slots.fill(0);
+    for(auto i = ex.hbegin(); i!=ex.hend(); i++) {
+	add_header(i->name.data(), i->name.size(),
+		   i->value.data(), i->value.size());
+    }
+    sightings.clear();
+    for(auto i = ex.sbegin(); i!=ex.send(); i++) {
+	sightings.emplace_back(i->sp,
+			       i->name.data(), i->name.size(),
+			       i->comment.data(), i->comment.size());
+    }
+    date = ex.date;
+    place = header(header::PLACE);
+    coordinate = ex.coordinate;
+}
+
+
+/**
+ * Make 'ex' a FieldList with the same contents.
+ */
+void FieldView::copy(FieldList& ex) const
+{
+    FieldList f;
+    std::string a;
+    std::string b;
+    for(const Header& h : headers) {
+	a = h.name.str();
+	b = h.value.str();
+	f.add_header(a.data(), a.size(), b.data(), b.size());
+    }
+    for(const Sighting& s : sightings) {
+	a = s.name.str();
+	b = s.comment.str();
+	f.add_sighting(s.sp, a.data(), a.size(), b.data(), b.size());
+    }
+    f.finalize(date);
+    ex.swap(f);
+}
+
+
+bool FieldView::add_header(const char* a, size_t alen,
+			   const char* b, size_t blen)
+{
+    const header::Known k = header::known(a, alen);
+    const bool was_present = k==header::OTHER
+	? has_header(std::string(a, alen))
+	: slots[k];
+    headers.emplace_back(a, alen, b, blen);
+    if(k!=header::OTHER && !was_present) slots[k] = headers.size();
+    return !was_present;
+}
+
+
+/**
+ * Let the last header value extend to the end of [a, a+alen), which
+ * comes after it in the same text.
+ */
+bool FieldView::add_header_cont(const char* a, size_t alen)
+{
+    if(headers.empty()) return false;
+    Text& value = headers.back().value;
+    value.span = a + alen - value.a;
+    return true;
+}
+
+
+bool FieldView::add_sighting(Taxa& spp,
+			     const char* a, size_t alen,
+			     const char* b, size_t blen)
+{
+    TaxonId id = spp.find(a, alen);
+    const bool familiar = id;
+    if(!familiar) {
+	id = spp.insert(std::string(a, alen));
+    }
+
+    sightings.emplace_back(id, a, alen, b, blen);
+    return familiar;
+}
+
+
+bool FieldView::add_sighting(const Taxa& spp,
+			     const char* a, size_t alen,
+			     const char* b, size_t blen)
+{
+    const TaxonId id = spp.find(a, alen);
+    if(!id) throw Unfamiliar();
+
+    sightings.emplace_back(id, a, alen, b, blen);
+    return true;
+}
+
+
+void FieldView::add_sighting(TaxonId sp,
+			     const char* a, size_t alen,
+			     const char* b, size_t blen)
+{
+    sightings.emplace_back(sp, a, alen, b, blen);
+}
+
+
+bool FieldView::add_sighting_cont(const char* a, size_t alen)
+{
+    if(sightings.empty()) return false;
+    Text& comment = sightings.back().comment;
+    comment.span = a + alen - comment.a;
+    return true;
+}
+
+
+bool FieldView::finalize()
+{
+    const Text& s = header(header::DATE);
+    if(s.simple()) return finalize(Date(s.a, s.a + s.n));
+    const std::string t = s.str();
+    return finalize(Date(t.data(), t.data() + t.size()));
+}
+
+
+bool FieldView::finalize(const Date& date)
+{
+    this->date = date;
+    place = header(header::PLACE);
+    const Text& s = header(header::COORDINATE);
+    if(s.simple()) {
+	coordinate = Coordinate(s.a, s.a + s.n);
+    }
+    else {
+	const std::string t = s.str();
+	coordinate = Coordinate(t.data(), t.data() + t.size());
+    }
+    return true;
+}
+
+
+bool FieldView::contains(TaxonId taxon) const
+{
+    return std::find_if(begin(sightings), end(sightings),
+			[taxon] (const Sighting& s) {
+			    return s.sp == taxon;
+			}) != end(sightings);
+}
+
+
+bool FieldView::has_one(const std::vector<TaxonId>& taxa) const
+{
+    auto is_taxon = [](const Sighting& s, TaxonId sp) {
+	return s.sp == sp;
+    };
+
+    return std::find_first_of(sightings.begin(), sightings.end(),
+			      taxa.begin(), taxa.end(),
+			      is_taxon) != sightings.end();
+}
+
+
+bool FieldView::has_one(const TaxonSet& taxa) const
+{
+    return std::any_of(sightings.begin(), sightings.end(),
+		       [&taxa] (const Sighting& s) {
+			   return taxa.contains(s.sp);
+		       });
+}
+
+
+bool FieldView::has_header(const std::string& name) const
+{
+    const header::Known k = header::known(name.data(), name.size());
+    if(k!=header::OTHER) return slots[k];
+    const char* const s = name.c_str();
+    return std::find_if(begin(headers), end(headers),
+			[s] (const Header& h) { return h.name==s; })
+	!= end(headers);
+}
+
+
+const FieldView::Text& FieldView::find_header(const char* name) const
+{
+    static const Text NIL;
+    const header::Known k = header::known(name, std::strlen(name));
+    if(k!=header::OTHER) return header(k);
+    auto i = std::find_if(begin(headers), end(headers),
+			  [name] (const Header& h) {
+			      return h.name==name;
+			  });
+    if(i==end(headers)) return NIL;
+    return i->value;
+}
+
+
+const FieldView::Text& FieldView::header(const header::Known name) const
+{
+    static const Text NIL;
+    const unsigned n = slots[name];
+    return n ? headers[n-1].value : NIL;
+}
+
+
+std::ostream& FieldView::put(std::ostream& os, const bool sort) const
+{
+    FieldList f;
+    copy(f);
+    return f.put(os, sort);
+}
@@ -0,0 +1,144 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_FIELDVIEW_H
+#define GROBLAD_FIELDVIEW_H
+
+#include "excursion.h"
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <cstdint>
+
+
+/**
+ * A read-only FieldList which doesn't own its text.  Headers and
+ * sightings refer to the text they were parsed from -- a mapped
+ * book, a Cache, or a FieldList -- which has to stay around for as
+ * long as the view is used.  Continuation lines aren't joined until
+ * someone asks for them.
+ *
+ * It has most of the FieldList interface, but Text where FieldList
+ * has strings.  copy() makes a FieldList of it, for anything else.
+ */
+class FieldView
+{
+public:
+    /**
+     * The text [a, a+n), and possibly continuation lines after it.
+     * They end at a+span, with lines in between which get() ignored:
+     * blank lines, # comments, and unindented ones -- unfilled
+     * sightings and broken lines.
+     */
+    struct Text {
+	Text() : a(""), n(0), span(0) {}
+	Text(const char* a, size_t n) : a(a), n(n), span(n) {}
+	const char* a;
+	uint32_t n;
+	uint32_t span;
+
+	bool empty() const { return !span; }
+	bool simple() const { return n==span; }
+	std::string str() const;
+	void append_to(std::string& s) const;
+	bool operator== (const char* s) const;
+	bool operator!= (const char* s) const { return !(*this==s); }
+    };
+
+    struct Header {
+	Header(const char* a, size_t alen,
+	       const char* b, size_t blen)
+	    : name(a, alen),
+	      value(b, blen)
+	{}
+	Text name;
+	Text value;
+	bool empty() const { return value.empty(); }
+    };
+    struct Sighting {
+	Sighting(TaxonId sp,
+		 const char* a, size_t alen,
+		 const char* b, size_t blen)
+	    : sp(sp),
+	      name(a, alen),
+	      comment(b, blen)
+	{}
+	TaxonId sp;
+	Text name;
+	Text comment;
+    };
+
+    void swap(FieldView& other);
+    void assign(const FieldList& ex);
+    void copy(FieldList& ex) const;
+
+    bool add_header(const char* a, size_t alen,
+		    const char* b, size_t blen);
+    bool add_header_cont(const char* a, size_t alen);
+
+    bool add_sighting(Taxa& spp,
+		      const char* a, size_t alen,
+		      const char* b, size_t blen);
+    bool add_sighting(const Taxa& spp,
+		      const char* a, size_t alen,
+		      const char* b, size_t blen);
+    void add_sighting(TaxonId sp,
+		      const char* a, size_t alen,
+		      const char* b, size_t blen);
+    bool add_sighting_cont(const char* a, size_t alen);
+    bool finalize();
+    bool finalize(const Date& date);
+
+    bool has_one(const std::vector<TaxonId>& taxa) const;
+    bool has_one(const TaxonSet& taxa) const;
+    bool contains(TaxonId taxon) const;
+
+    std::ostream& put(std::ostream& os, bool sort = false) const;
+
+    typedef std::vector<Header> Headers;
+    typedef std::vector<Sighting> Sightings;
+    Headers::const_iterator hbegin() const { return begin(headers); }
+    Headers::const_iterator hend() const { return end(headers); }
+    Sightings::const_iterator sbegin() const { return begin(sightings); }
+    Sightings::const_iterator send() const { return end(sightings); }
+
+    bool has_header(const std::string& name) const;
+    const Text& find_header(const char* name) const;
+    const Text& header(header::Known name) const;
+
+    Date date;
+    Text place;
+    Coordinate coordinate;
+
+private:
+    Headers headers;
+    Sightings sightings;
+    std::array<unsigned, header::OTHER> slots = {{}};
+};
+
+using ExcursionView = FieldView;
+
+std::ostream& operator<< (std::ostream& os, const FieldView::Text& val);
+
+void check_sightings(const FieldView& ex, const Taxa& taxa,
+		     const Files& is, std::ostream& err);
+void check_last_header(const FieldView& ex,
+		       const Files& is, std::ostream& err);
+void check_last_sighting(const FieldView& ex,
+			 const Files& is, std::ostream& err);
+
+bool get(Files& is, std::ostream& errstream,
+	 Taxa& spp, FieldView& excursion);
+bool get(Files& is, std::ostream& errstream,
+	 const Taxa& spp, FieldView& excursion);
+
+inline
+std::ostream& operator<< (std::ostream& os, const FieldView& val)
+{
+    return val.put(os);
+}
+
+#endif
@@ -1,17 +1,51 @@
 /*
- * Copyright (c) 2013, 2017, 2018 Jrgen Grahn
+ * Copyright (c) 2013, 2017, 2018, 2026 Jörgen Grahn
  * All rights reserved.
  *
  */
 #include "files...h"
 
+#include "lineparse.h"
+
 #include <cstring>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
 namespace {
     static const std::string std_in = "<stdin>";
 }
 
 
+/**
+ * Read from 'segments' rather than from files, e.g. to parse part
+ * of a file which was read earlier. The memory has to stay valid.
+ */
+Files::Files(const std::vector<Segment>& segments)
+    : segs(segments),
+      started(false),
+      fd(-1),
+      p(0),
+      e(0),
+      start(0),
+      base(0),
+      pos{"", 0},
+      err(&std::cerr)
+{
+    for(const Segment& seg : segs) ff.push_back(seg.pos.file);
+    f = ff.begin();
+}
+
+
+Files::~Files()
+{
+    close();
+}
+
+
 /**
  * The input position, on the traditional "file:line"
  * format. Standard input is called "<stdin>".
@@ -43,47 +77,212 @@ std::ostream& operator<< (std::ostream& os, const Files::Position& val)
 
 
 /**
- * The slowpath part of getline(). Called whenever an ordinary
- * std::getline() fails.
+ * The mapping the current file's lines are in, or null if they're
+ * in a buffer which the next getline() may reuse (or in memory which
+ * the caller owns).
+ */
+std::shared_ptr<const Mmap> Files::mapping() const
+{
+    return map;
+}
+
+
+/**
+ * True if the next getline() would start on the next file, or find
+ * the end of input: what's left of the current file is, at most,
+ * blank lines and comments, and these are skipped.  True also before
+ * the first getline().
+ */
+bool Files::exhausted()
+{
+    if(!started || f==ff.end()) return true;
+
+    const char* a;
+    const char* b;
+    unsigned n = 0;
+    while(next_line(a, b)) {
+	const char* c = Parse::ws(a, b);
+	if(c!=b && *c!='#') {
+	    /* still in the buffer; put it back */
+	    p = a;
+	    pos.line += n;
+	    return false;
+	}
+	n++;
+    }
+    return true;
+}
+
+
+/**
+ * The index in the list of files of the one after the current one,
+ * i.e. the one getline() continues with once exhausted().
+ */
+size_t Files::next() const
+{
+    return started ? f - ff.begin() + 1 : 0;
+}
+
+
+/**
+ * The name of the next() file, or null if there is none.
+ */
+const std::string* Files::upcoming() const
+{
+    const size_t n = next();
+    return n < ff.size() ? &ff[n] : 0;
+}
+
+
+/**
+ * When exhausted(), skip the upcoming() file without reading it, as
+ * if it had been read to the end.
+ */
+void Files::skip()
+{
+    if(started) {
+	close();
+	f++;
+    }
+    started = true;
+    pos = {*f, 0};
+}
+
+
+/**
+ * The slowpath part of getline(). Called whenever there's no complete
+ * line in the buffer.
  */
-bool Files::getline_helper(std::string& s)
+bool Files::getline_helper(const char*& a, const char*& b)
 {
     if(ff.empty()) return false;
 
-    if(!is && f==ff.begin()) {
+    if(!started) {
 	/* first getline() ever */
+	started = true;
 	open();
     }
 
-    while(!std::getline(*is, s)) {
+    while(f!=ff.end()) {
+
+	if(next_line(a, b)) return true;
 
-	fs.close();
+	close();
 	f++;
-	if(f==ff.end()) {
-	    return false;
-	}
-	else {
-	    open();
-	}
+	if(f!=ff.end()) open();
     }
 
+    return false;
+}
+
+
+/**
+ * Find the next line in the current file, reading more of it if
+ * needed. Like std::getline(), accepts a last line without a
+ * terminating newline.
+ */
+bool Files::next_line(const char*& a, const char*& b)
+{
+    /* how much of a partial line is known to have no newline */
+    size_t seen = 0;
+    do {
+	const char* const s = p + seen;
+	const void* nl = s!=e ? std::memchr(s, '\n', e - s) : 0;
+	if(nl) {
+	    a = p;
+	    b = static_cast<const char*>(nl);
+	    p = b + 1;
+	    return true;
+	}
+	seen = e - p;
+    } while(fill());
+
+    if(p==e) return false;
+    a = p;
+    b = e;
+    p = e;
     return true;
 }
 
 
+/**
+ * Move any partial line to the start of the buffer, and read(2) as
+ * much as fits after it.  Returns false at end of file (or error),
+ * and always for a mapped file, which is already complete.
+ */
+bool Files::fill()
+{
+    if(fd==-1 || map) return false;
+
+    const size_t n = e - p;
+    base += p - start;
+    if(buf.empty()) {
+	buf.resize(1 << 18);
+    }
+    else if(n==buf.size()) {
+	/* a huge line, already at the start of the buffer */
+	buf.resize(2 * n);
+	p = &buf[0];
+    }
+    char* const q = &buf[0];
+    if(n && p!=q) std::memmove(q, p, n);
+
+    ssize_t rc;
+    while((rc = read(fd, q + n, buf.size() - n)) == -1 && errno==EINTR) {}
+    if(rc==-1) {
+	*err << "error: cannot read '" << pos.file
+	     << "': " << std::strerror(errno) << '\n';
+    }
+
+    p = start = q;
+    e = q + n + (rc>0 ? rc : 0);
+    return rc>0;
+}
+
+
 void Files::open()
 {
+    p = e = start = 0;
+    base = 0;
+
+    if(!segs.empty()) {
+	const Segment& seg = segs[f - ff.begin()];
+	pos = seg.pos;
+	p = start = seg.a;
+	e = seg.b;
+	base = seg.offset;
+	return;
+    }
+
     if(*f=="-") {
 	pos = {std_in, 1};
-	is = &std::cin;
+	fd = 0;
     }
     else {
 	pos = {*f, 1};
-	fs.open(*f, std::ios_base::in);
-	is = &fs;
-	if(!fs.is_open()) {
-	    std::cerr << "error: cannot open '" << pos.file
-		      << "' for reading: " << std::strerror(errno) << '\n';
+	fd = ::open(f->c_str(), O_RDONLY);
+	if(fd==-1) {
+	    *err << "error: cannot open '" << pos.file
+		 << "' for reading: " << std::strerror(errno) << '\n';
+	    return;
+	}
+	map = std::make_shared<Mmap>(fd);
+	if(map->valid()) {
+	    p = start = map->begin();
+	    e = map->end();
+	}
+	else {
+	    map.reset();
 	}
     }
 }
+
+
+void Files::close()
+{
+    map.reset();
+    if(fd>0) ::close(fd);
+    fd = -1;
+    p = e = start = 0;
+    base = 0;
+}
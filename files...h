@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2012, 2013, 2018 Jrgen Grahn
+ * Copyright (c) 2012, 2013, 2018, 2026 Jörgen Grahn
  * All rights reserved.
  */
 #ifndef FILES___H
@@ -9,7 +9,10 @@
 #include <string>
 #include <vector>
 #include <iostream>
-#include <fstream>
+#include <cstring>
+#include <memory>
+
+#include "mmap.h"
 
 
 /**
@@ -26,14 +29,23 @@
  * - you want file name and line number information for diagnostics,
  *   even for standard input
  *
+ * Regular files are mapped into memory; pipes and standard input are
+ * read(2) in large chunks. Either way, getline(const char*&, const
+ * char*&) hands out lines without copying them.  A mapping can be
+ * shared, to keep its lines around after the file is closed.
+ *
+ * Failing to open or read a file is reported to std::cerr, or to
+ * the stream given to errors().
  */
 class Files {
 public:
     template <class It>
     Files(It begin, It end,
 	  bool empty_is_stdin = true);
+    ~Files();
 
     bool getline(std::string& s);
+    bool getline(const char*& a, const char*& b);
 
     struct Position {
 	Position(const std::string& file, const unsigned line)
@@ -43,21 +55,59 @@ public:
 	std::string file;
 	unsigned line;
     };
+
+    /**
+     * Lines [a, b) which are already in memory, and originally
+     * started at 'pos', 'offset' octets into that file.
+     */
+    struct Segment {
+	Segment(const Position& pos, const char* a, const char* b,
+		size_t offset = 0)
+	    : pos(pos), a(a), b(b), offset(offset)
+	{}
+	Position pos;
+	const char* a;
+	const char* b;
+	size_t offset;
+    };
+    explicit Files(const std::vector<Segment>& segments);
+
+    void errors(std::ostream& os) { err = &os; }
+
+    bool exhausted();
+    size_t next() const;
+    const std::string* upcoming() const;
+    void skip();
+
     const Position& position() const;
     Position prev_position() const;
+    /* of the next line, in the current file */
+    size_t offset() const { return base + (p - start); }
+    std::shared_ptr<const Mmap> mapping() const;
 
 private:
     Files(const Files&);
     Files& operator= (const Files&);
 
-    bool getline_helper(std::string& s);
+    bool getline_helper(const char*& a, const char*& b);
+    bool next_line(const char*& a, const char*& b);
+    bool fill();
     void open();
+    void close();
 
     std::vector<std::string> ff;
     std::vector<std::string>::const_iterator f;
-    std::istream* is;
-    std::ifstream fs;
+    std::vector<Segment> segs;
+    bool started;
+    int fd;
+    std::shared_ptr<Mmap> map;
+    std::vector<char> buf;
+    const char* p;
+    const char* e;
+    const char* start;
+    size_t base;
     Position pos;
+    std::ostream* err;
 };
 
 
@@ -68,13 +118,34 @@ private:
  */
 inline
 bool Files::getline(std::string& s)
+{
+    const char* a;
+    const char* b;
+    if(!getline(a, b)) return false;
+    s.assign(a, b);
+    return true;
+}
+
+
+/**
+ * Like getline(std::string&), but the line is [a, b), excluding the
+ * newline. It stays valid until the next call.
+ */
+inline
+bool Files::getline(const char*& a, const char*& b)
 {
     pos.line++;
-    if(is && std::getline(*is, s)) {
-	return true;
+    if(p!=e) {
+	const void* nl = std::memchr(p, '\n', e - p);
+	if(nl) {
+	    a = p;
+	    b = static_cast<const char*>(nl);
+	    p = b + 1;
+	    return true;
+	}
     }
 
-    return getline_helper(s);
+    return getline_helper(a, b);
 }
 
 
@@ -86,8 +157,14 @@ template <class It>
 Files::Files(It begin, It end,
 	     bool empty_is_stdin)
     : ff(begin, end),
-      is(0),
-      pos{"", 0}
+      started(false),
+      fd(-1),
+      p(0),
+      e(0),
+      start(0),
+      base(0),
+      pos{"", 0},
+      err(&std::cerr)
 {
     if(ff.empty() && empty_is_stdin) ff.push_back("-");
     f = ff.begin();
@@ -1,4 +1,4 @@
-/* Copyright (c) 2013 Jrgen Grahn
+/* Copyright (c) 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
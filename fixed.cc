@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "fixed.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+    /**
+     * The octet 'c', in lower case, given the octets before and
+     * after it.  In UTF-8, capital letters in the Latin-1 range are
+     * 0xc3 0x80--0x9e and small ones 0xc3 0xa0--0xbe; in Latin-1
+     * they are 0xc0--0xde and 0xe0--0xfe.  0xd7 is the
+     * multiplication sign in both, and has no case.
+     */
+    unsigned char fold(const unsigned char prev,
+		       const unsigned char c,
+		       const unsigned char next)
+    {
+	if(c >= 'A' && c <= 'Z') return c + 0x20;
+	if(c < 0x80) return c;
+	if(prev==0xc3 && c >= 0x80 && c <= 0x9e && c != 0x97) return c + 0x20;
+	if(c==0xc3 && (next & 0xc0)==0x80) return c;
+	if(c >= 0xc0 && c <= 0xde && c != 0xd7) return c + 0x20;
+	return c;
+    }
+
+    unsigned char fold(const unsigned char c)
+    {
+	if(c >= 'A' && c <= 'Z') return c + 0x20;
+	return c;
+    }
+
+    /**
+     * The other octet which fold()s to 'c', or 'c' itself.
+     */
+    unsigned char unfold(const unsigned char c, const bool ascii)
+    {
+	if(c >= 'a' && c <= 'z') return c - 0x20;
+	if(ascii) return c;
+	if(c >= 0xa0 && c <= 0xbe && c != 0xb7) return c - 0x20;
+	if(c >= 0xe0 && c <= 0xfe && c != 0xf7) return c - 0x20;
+	return c;
+    }
+
+    unsigned char octet(const char* a, const char* p, const char* b)
+    {
+	return a <= p && p < b ? *p : 0;
+    }
+
+#if defined(__AVX2__)
+    const long block = 32;
+
+    inline unsigned candidates(const char* p, const char* q,
+			       const unsigned char* f,
+			       const unsigned char* l)
+    {
+	auto load = [] (const char* p) {
+	    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	};
+	auto either = [] (const __m256i v, const unsigned char* c) {
+	    return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c[0])),
+				   _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c[1])));
+	};
+	return _mm256_movemask_epi8(_mm256_and_si256(either(load(p), f),
+						     either(load(q), l)));
+    }
+#elif defined(__SSE2__)
+    const long block = 16;
+
+    inline unsigned candidates(const char* p, const char* q,
+			       const unsigned char* f,
+			       const unsigned char* l)
+    {
+	auto load = [] (const char* p) {
+	    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	};
+	auto either = [] (const __m128i v, const unsigned char* c) {
+	    return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(c[0])),
+				_mm_cmpeq_epi8(v, _mm_set1_epi8(c[1])));
+	};
+	return _mm_movemask_epi8(_mm_and_si128(either(load(p), f),
+					       either(load(q), l)));
+    }
+#else
+    const long block = 0;
+
+    inline unsigned candidates(const char*, const char*,
+			       const unsigned char*,
+			       const unsigned char*)
+    {
+	return 0;
+    }
+#endif
+}
+
+
+Fixed::Fixed(const std::string& s, const bool ascii)
+    : ascii(ascii)
+{
+    const char* const a = s.data();
+    const char* const b = a + s.size();
+    for(const char* p = a; p!=b; p++) {
+	pattern.push_back(ascii ? fold(*p)
+				: fold(octet(a, p-1, b), *p, octet(a, p+1, b)));
+    }
+    if(pattern.empty()) return;
+    first[0] = pattern.front();
+    first[1] = unfold(first[0], ascii);
+    last[0] = pattern.back();
+    last[1] = unfold(last[0], ascii);
+}
+
+
+bool Fixed::match(const std::string& s) const
+{
+    return match(s.data(), s.data() + s.size());
+}
+
+
+/**
+ * True if the pattern is somewhere in [a, b).  Candidates are the
+ * places where the first and the last octet match, a block of them
+ * at a time; they're then compared in full.
+ */
+bool Fixed::match(const char* const a, const char* const b) const
+{
+    const long n = pattern.size();
+    if(!n) return true;
+    if(b - a < n) return false;
+
+    const char* p = a;
+    while(block && b - (p + n - 1) >= block) {
+	unsigned m = candidates(p, p + n - 1, first, last);
+	while(m) {
+	    if(at(a, p + __builtin_ctz(m), b)) return true;
+	    m &= m - 1;
+	}
+	p += block;
+    }
+    for(; b - p >= n; p++) {
+	const unsigned char c = *p;
+	if(c!=first[0] && c!=first[1]) continue;
+	if(at(a, p, b)) return true;
+    }
+    return false;
+}
+
+
+/**
+ * Helper. True if the pattern is at 'p' in [a, b).
+ */
+bool Fixed::at(const char* const a, const char* const p,
+	       const char* const b) const
+{
+    for(size_t i = 0; i < pattern.size(); i++) {
+	const char* const q = p + i;
+	const unsigned char c = ascii ? fold(*q)
+				      : fold(octet(a, q-1, b), *q, octet(a, q+1, b));
+	if(c != (unsigned char)pattern[i]) return false;
+    }
+    return true;
+}
+
+
+Literals::Literals(const std::vector<std::string>& strings)
+{
+    for(const std::string& s : strings) {
+	const unsigned i = v.size();
+	v.emplace_back();
+	std::string& t = v.back();
+	for(char c : s) t.push_back(fold(c));
+	if(t.empty()) {
+	    empty.push_back(i);
+	}
+	else {
+	    bucket[(unsigned char)t[0]].push_back(i);
+	}
+    }
+}
+
+
+/**
+ * Set found[i] for the strings which are somewhere in [a, b).  The
+ * ones already set aren't looked for.
+ */
+void Literals::find(const char* const a, const char* const b,
+		    std::vector<bool>& found) const
+{
+    for(unsigned i : empty) found[i] = true;
+
+    for(const char* p = a; p!=b; p++) {
+	for(unsigned i : bucket[fold(*p)]) {
+	    if(found[i]) continue;
+	    const std::string& s = v[i];
+	    if(size_t(b - p) < s.size()) continue;
+	    size_t j = 1;
+	    while(j < s.size() && fold(p[j])==(unsigned char)s[j]) j++;
+	    if(j==s.size()) found[i] = true;
+	}
+    }
+}
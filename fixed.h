@@ -0,0 +1,62 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_FIXED_H
+#define GROBLAD_FIXED_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+
+/**
+ * A fixed string to search for, ignoring case.  It can be used
+ * instead of a Regex when the pattern is just a word or two, and is
+ * much faster.
+ *
+ * Case is ignored for ASCII letters, and for the other letters of
+ * ISO 8859-1 (å, ä, ö and so on) whether they're encoded as Latin-1
+ * or as UTF-8.  The pattern and the text should use the same
+ * encoding, though.  With 'ascii', only ASCII letters have case,
+ * like for regcomp(3) with REG_ICASE in the C locale.
+ */
+class Fixed
+{
+public:
+    explicit Fixed(const std::string& s, bool ascii = false);
+
+    bool match(const std::string& s) const;
+    bool match(const char* s) const { return match(s, s + std::strlen(s)); }
+    bool match(const char* a, const char* b) const;
+
+private:
+    bool at(const char* a, const char* p, const char* b) const;
+
+    const bool ascii;
+    std::string pattern;
+    unsigned char first[2];
+    unsigned char last[2];
+};
+
+
+/**
+ * Several fixed strings to search for at once, in one pass over the
+ * text, ignoring case like a Fixed with 'ascii'.  Meant for ruling
+ * out most of a set of Regexes in one go, by what they require.
+ */
+class Literals
+{
+public:
+    explicit Literals(const std::vector<std::string>& v);
+
+    void find(const char* a, const char* b, std::vector<bool>& found) const;
+
+private:
+    std::vector<std::string> v;
+    std::vector<unsigned> empty;
+    std::vector<unsigned> bucket[256];
+};
+
+#endif
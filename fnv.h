@@ -0,0 +1,27 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_FNV_H
+#define GROBLAD_FNV_H
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * The FNV-1a hash of [s, s+n), for hash tables of names.  Taxa
+ * snapshots are made with it, so it mustn't change.
+ */
+inline uint32_t fnv1a(const char* s, const size_t n)
+{
+    uint32_t h = 2166136261u;
+    for(size_t i=0; i<n; i++) {
+	h ^= static_cast<unsigned char>(s[i]);
+	h *= 16777619u;
+    }
+    return h;
+}
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "grep.h"
+
+#include "files...h"
+#include "taxa.h"
+#include "fieldview.h"
+#include "regex.h"
+#include "fixed.h"
+#include "taxonset.h"
+#include "parser.h"
+
+#include <iostream>
+#include <algorithm>
+
+
+namespace {
+
+    /**
+     * True if 're' matches 's'.  Unless it has continuation lines,
+     * that's done in place, without copying it.
+     */
+    template<class Regex>
+    bool match(const Regex& re, const FieldView::Text& s)
+    {
+	if(s.simple()) return re.match(s.a, s.a + s.n);
+	return re.match(s.str());
+    }
+
+    /**
+     * True if 'ex' matches 're' in some way, or if it contains
+     * one of 'taxa'.
+     */
+    template<class Regex>
+    bool matches(const Regex& re, const FieldView& ex,
+		 const TaxonSet& taxa)
+    {
+	if(ex.has_one(taxa)) return true;
+	for(FieldView::Headers::const_iterator i = ex.hbegin();
+	    i != ex.hend();
+	    i++) {
+	    if(match(re, i->value)) return true;
+	}
+	for(FieldView::Sightings::const_iterator i = ex.sbegin();
+	    i != ex.send();
+	    i++) {
+	    if(match(re, i->name)) return true;
+	    if(match(re, i->comment)) return true;
+	}
+
+	return false;
+    }
+
+    /**
+     * What each of 're' needs to find in a text to match it, or
+     * nothing if that's not known.
+     */
+    std::vector<std::string>
+    literals(const std::vector<std::unique_ptr<Regex>>& re)
+    {
+	std::vector<std::string> acc;
+	for(const auto& r : re) acc.push_back(r->literal());
+	return acc;
+    }
+
+    std::vector<std::string>
+    literals(const std::vector<std::unique_ptr<Fixed>>&)
+    {
+	return {};
+    }
+
+    void find(const Literals& lit, const FieldView::Text& s,
+	      std::vector<bool>& found)
+    {
+	if(s.simple()) {
+	    lit.find(s.a, s.a + s.n, found);
+	    return;
+	}
+	const std::string t = s.str();
+	lit.find(t.data(), t.data() + t.size(), found);
+    }
+
+    /**
+     * Which patterns may match some part of 'ex' which matches()
+     * looks at, given their literals 'lit'.  The others certainly
+     * don't.
+     */
+    void candidates(const Literals& lit, const FieldView& ex,
+		    std::vector<bool>& maybe)
+    {
+	std::fill(maybe.begin(), maybe.end(), false);
+	for(FieldView::Headers::const_iterator i = ex.hbegin();
+	    i != ex.hend();
+	    i++) {
+	    find(lit, i->value, maybe);
+	}
+	for(FieldView::Sightings::const_iterator i = ex.sbegin();
+	    i != ex.send();
+	    i++) {
+	    find(lit, i->name, maybe);
+	    find(lit, i->comment, maybe);
+	}
+    }
+
+    template<class Regex>
+    void run(const std::vector<std::unique_ptr<Regex>>& re,
+	     const std::vector<size_t>& dest,
+	     std::vector<grep::Output>& out,
+	     Files& files, Taxa& taxa, unsigned jobs,
+	     bool taxa_only, bool invert)
+    {
+	std::vector<TaxonSet> matchset;
+	std::vector<TaxonId> all;
+	for(const auto& r : re) {
+	    const std::vector<TaxonId> matchtx = taxa.match(*r);
+	    matchset.emplace_back(matchtx);
+	    all.insert(all.end(), matchtx.begin(), matchtx.end());
+	}
+	std::sort(all.begin(), all.end());
+	all.erase(std::unique(all.begin(), all.end()), all.end());
+
+	/* With several patterns, their literals are looked for
+	 * together first, to rule most of them out.
+	 */
+	const std::vector<std::string> lv = literals(re);
+	const Literals lit(lv);
+	const bool prefilter = re.size() > 1 && !taxa_only &&
+	    std::any_of(lv.begin(), lv.end(),
+			[] (const std::string& s) { return !s.empty(); });
+	std::vector<bool> maybe(re.size(), true);
+
+	Parser parser(files, std::cerr, taxa, jobs);
+	if(taxa_only && !invert) parser.only(all);
+	FieldView ex;
+	std::vector<bool> hit(out.size());
+	while(parser.get(ex)) {
+
+	    if(prefilter) candidates(lit, ex, maybe);
+	    std::fill(hit.begin(), hit.end(), false);
+	    for(size_t i = 0; i < re.size(); i++) {
+		if(hit[dest[i]]) continue;
+		const bool match = (taxa_only || !maybe[i])
+		    ? ex.has_one(matchset[i])
+		    : matches(*re[i], ex, matchset[i]);
+		hit[dest[i]] = invert ^ match;
+	    }
+	    for(size_t i = 0; i < out.size(); i++) {
+		if(!hit[i]) continue;
+		grep::Output& o = out[i];
+		if(o.n++) o.os << '\n';
+		o.os << ex;
+	    }
+	}
+    }
+}
+
+
+/**
+ * Read a pattern file, named 'file', from 'is': lines with an output
+ * file name (or '-' for standard output), whitespace, and a pattern.
+ * Empty lines and lines starting with '#' are ignored.  Fails,
+ * with a complaint to 'err', on a line without a pattern.
+ */
+bool grep::patterns(std::vector<Pattern>& acc,
+		    std::istream& is, const std::string& file,
+		    std::ostream& err)
+{
+    const char ws[] = " \t";
+    std::string s;
+    unsigned n = 0;
+    while(std::getline(is, s)) {
+	n++;
+	const size_t a = s.find_first_not_of(ws);
+	if(a==std::string::npos || s[a]=='#') continue;
+	const size_t b = s.find_first_of(ws, a);
+	const size_t c = b==std::string::npos ? b : s.find_first_not_of(ws, b);
+	if(c==std::string::npos) {
+	    err << file << ':' << n << ": missing pattern\n";
+	    return false;
+	}
+	acc.emplace_back(s.substr(a, b - a), s.substr(c));
+    }
+    return true;
+}
+
+
+/**
+ * Print the excursions in 'files' which match re[i] (or with
+ * 'invert', the ones which don't) to out[dest[i]]. The files
+ * are only parsed once, and an excursion which several patterns
+ * send to the same output is only printed once there.
+ */
+void grep::grep(const std::vector<std::unique_ptr<Regex>>& re,
+		const std::vector<size_t>& dest,
+		std::vector<Output>& out,
+		Files& files, Taxa& taxa, unsigned jobs,
+		bool taxa_only, bool invert)
+{
+    run(re, dest, out, files, taxa, jobs, taxa_only, invert);
+}
+
+
+void grep::grep(const std::vector<std::unique_ptr<Fixed>>& re,
+		const std::vector<size_t>& dest,
+		std::vector<Output>& out,
+		Files& files, Taxa& taxa, unsigned jobs,
+		bool taxa_only, bool invert)
+{
+    run(re, dest, out, files, taxa, jobs, taxa_only, invert);
+}
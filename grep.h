@@ -0,0 +1,55 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_GREP_H
+#define GROBLAD_GREP_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <iosfwd>
+
+class Files;
+class Taxa;
+class Regex;
+class Fixed;
+
+/**
+ * The parts of groblad_grep(1) which aren't about the command line.
+ */
+namespace grep {
+
+    /**
+     * Where the excursions matching a pattern go.
+     */
+    struct Output {
+	explicit Output(std::ostream& os) : os(os), n(0) {}
+	std::ostream& os;
+	unsigned n;
+    };
+
+    /**
+     * An output name and a pattern.
+     */
+    typedef std::pair<std::string, std::string> Pattern;
+
+    bool patterns(std::vector<Pattern>& acc,
+		  std::istream& is, const std::string& file,
+		  std::ostream& err);
+
+    void grep(const std::vector<std::unique_ptr<Regex>>& re,
+	      const std::vector<size_t>& dest,
+	      std::vector<Output>& out,
+	      Files& files, Taxa& taxa, unsigned jobs,
+	      bool taxa_only, bool invert);
+    void grep(const std::vector<std::unique_ptr<Fixed>>& re,
+	      const std::vector<size_t>& dest,
+	      std::vector<Output>& out,
+	      Files& files, Taxa& taxa, unsigned jobs,
+	      bool taxa_only, bool invert);
+}
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2014, 2018 Jrgen Grahn
+ * Copyright (c) 2013, 2014, 2018 Jörgen Grahn
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,6 +39,7 @@
 #include "taxa.h"
 #include "files...h"
 #include "excursion.h"
+#include "book.h"
 #include "lineparse.h"
 #include "editor.h"
 #include "filetest.h"
@@ -176,20 +177,16 @@ namespace {
     }
 
 
-    std::vector<Excursion> read(std::ostream& cerr,
-				Taxa& taxa,
-				const std::string& file)
+    void read(std::ostream& cerr,
+	      Taxa& taxa,
+	      const std::string& file,
+	      Book& book)
     {
 	Files in(&file, &file+1);
-	std::vector<Excursion> acc;
-	const Excursion nil;
-
 	Excursion ex;
 	while(get(in, cerr, taxa, ex)) {
-	    acc.push_back(nil);
-	    acc.back().swap(ex);
+	    book.add(ex);
 	}
-	return acc;
     }
 
 
@@ -201,10 +198,11 @@ namespace {
 		 Taxa& taxa,
 		 const std::string& file)
     {
-	const std::vector<Excursion> book = read(cerr, taxa, file);
+	Book book;
+	read(cerr, taxa, file, book);
 	std::ofstream os(file);
 
-	for(const Excursion& ex : book) {
+	for(const Book::Entry& ex : book) {
 	    os << ex << '\n';
 	}
 
@@ -227,10 +225,11 @@ namespace {
 		    const std::string& src,
 		    const std::string& dest)
     {
-	const std::vector<Excursion> book = read(cerr, taxa, src);
+	Book book;
+	read(cerr, taxa, src, book);
 	std::ofstream os(dest, std::ios_base::app);
 
-	for(const Excursion& ex : book) {
+	for(const Book::Entry& ex : book) {
 	    os << '\n' << ex;
 	}
 
@@ -344,7 +343,7 @@ int main(int argc, char ** argv)
 	case 'V':
 	    std::cout << prog << ", part of "
 		      << groblad_name() << ' ' << groblad_version() << "\n"
-		      << "Copyright (c) 2004 - 2013, 2018 Jrgen Grahn\n";
+		      << "Copyright (c) 2004 - 2013, 2018 Jörgen Grahn\n";
 	    return 0;
 	    break;
 	case 'H':
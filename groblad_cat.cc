@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1999--2001, 2013 Jrgen Grahn
+ * Copyright (c) 1999--2001, 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -26,13 +26,18 @@
  */
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 #include <stdio.h>
 #include <getopt.h>
 
 #include "files...h"
 #include "taxa.h"
 #include "excursion.h"
+#include "parser.h"
+#include "pipeline.h"
 
 
 extern "C" {
@@ -46,14 +51,14 @@ int main(int argc, char ** argv)
 {
     const std::string prog = argv[0];
     const std::string usage = std::string("usage: ")
-	+ prog + " [-cx] [-s species] file ...\n"
+	+ prog + " [-cx] [-s species] [-j jobs | -p] file ...\n"
 	"       "
-	+ prog + " [-s species] --check file ...\n"
+	+ prog + " [-s species] [-j jobs] --check file ...\n"
 	"       "
 	+ prog + " [-s species] --taxa\n"
 	"       "
 	+ prog + " --version";
-    const char optstring[] = "gcxs:";
+    const char optstring[] = "gcxs:j:p";
     const struct option long_options[] = {
 	{"check", 0, 0, 'C'},
 	{"taxa", 0, 0, 'T'},
@@ -69,6 +74,8 @@ int main(int argc, char ** argv)
     bool just_list_taxa = false;
     bool sort_spp = false;
     char outfmt = 'g';
+    unsigned jobs = 1;
+    bool pipelined = false;
 
     int ch;
     while((ch = getopt_long(argc, argv,
@@ -84,6 +91,12 @@ int main(int argc, char ** argv)
 	case 'x':
 	    sort_spp = true;
 	    break;
+	case 'j':
+	    jobs = std::max(1, std::atoi(optarg));
+	    break;
+	case 'p':
+	    pipelined = true;
+	    break;
 	case 'T':
 	    just_list_taxa = true;
 	    break;
@@ -93,7 +106,7 @@ int main(int argc, char ** argv)
 	case 'V':
 	    std::cout << prog << ", part of "
 		      << groblad_name() << ' ' << groblad_version() << "\n"
-		      << "Copyright (c) 2004 - 2013, 2020 Jrgen Grahn\n";
+		      << "Copyright (c) 2004 - 2013, 2020 Jörgen Grahn\n";
 	    return 0;
 	    break;
 	case 'H':
@@ -118,24 +131,39 @@ int main(int argc, char ** argv)
                   << "' for reading: " << std::strerror(errno) << '\n';
         return 1;
     }
-    Taxa taxa(species, std::cerr);
+    Taxa taxa(species_file, species, std::cerr);
     species.close();
 
     if(just_list_taxa) {
 	taxa.put(std::cout);
     }
+    else if(outfmt=='g' && pipelined) {
+	Pipeline pipeline(files, taxa);
+	unsigned n = 0;
+	while(std::unique_ptr<Parsed> p = pipeline.get()) {
+	    for(const Parsed::Item& item : p->items) {
+		std::cerr << item.err;
+		if(n++) std::cout << '\n';
+
+		item.ex.put(std::cout, sort_spp);
+	    }
+	    std::cerr << p->err;
+	}
+    }
     else if(outfmt=='g') {
+	Parser parser(files, std::cerr, taxa, jobs);
 	Excursion ex;
 	unsigned n = 0;
-	while(get(files, std::cerr, taxa, ex)) {
+	while(parser.get(ex)) {
 	    if(n++) std::cout << '\n';
 
 	    ex.put(std::cout, sort_spp);
 	}
     }
     else if(outfmt=='-') {
+	Parser parser(files, std::cout, taxa, jobs);
 	Excursion ex;
-	while(get(files, std::cout, taxa, ex)) {
+	while(parser.get(ex)) {
 	    ;
 	}
     }
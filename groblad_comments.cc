@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Jrgen Grahn
+ * Copyright (c) 2018 Jörgen Grahn
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -26,6 +26,7 @@
  */
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <cstring>
 #include <algorithm>
 #include <getopt.h>
@@ -33,6 +34,8 @@
 #include "files...h"
 #include "taxa.h"
 #include "excursion.h"
+#include "fieldview.h"
+#include "parser.h"
 #include "names.h"
 #include "indent.h"
 #include "lineparse.h"
@@ -198,7 +201,7 @@ int main(int argc, char ** argv)
 	case 'V':
 	    std::cout << prog << ", part of "
 		      << groblad_name() << ' ' << groblad_version() << "\n"
-		      << "Copyright (c) 2018 Jrgen Grahn\n";
+		      << "Copyright (c) 2018 Jörgen Grahn\n";
 	    return 0;
 	    break;
 	case 'H':
@@ -227,22 +230,25 @@ int main(int argc, char ** argv)
 		  << "' for reading: " << std::strerror(errno) << '\n';
 	return 1;
     }
-    Taxa taxa(species, std::cerr);
+    Taxa taxa(taxa_file, species, std::cerr);
     species.close();
     const Names taxa_set {taxa.names()};
 
     species.open(Taxa::species_file(), std::ios_base::in);
-    Taxa gtaxa(species, std::cerr);
+    Taxa gtaxa(Taxa::species_file(), species, std::cerr);
     species.close();
 
     Files files(argv+optind, argv+argc);
 
+    Parser parser(files, std::cerr, gtaxa);
     Indent indent;
+    FieldView view;
     Excursion ex;
     unsigned n = 0;
-    while(get(files, std::cerr, gtaxa, ex)) {
-	const auto& comments = ex.find_header("comments");
-	if(comments.empty()) continue;
+    while(parser.get(view)) {
+	if(view.header(header::COMMENTS).empty()) continue;
+	view.copy(ex);
+	const auto& comments = ex.header(header::COMMENTS);
 
 	if(n++) std::cout << '\n';
 
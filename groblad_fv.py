@@ -3,7 +3,7 @@
 #
 # $Id: groblad_fv.py,v 1.12 2011-07-16 21:36:10 grahn Exp $
 #
-# Copyright (c) 2011, 2013 Jrgen Grahn
+# Copyright (c) 2011, 2013 Jörgen Grahn
 # All rights reserved.
 #
 
@@ -12,7 +12,7 @@ import sys
 
 
 class Point:
-    """A point in the Rikets Nt.
+    """A point in the Rikets Nät.
     """
     def __init__(self, north, east):
         """Create a point based on its north and east values.
@@ -78,59 +78,59 @@ class Record(object):
     """A single record, which gets appended to and finally converted and printed.
     """
     _official = ('artnamn', 'antal', 'enhet',
-                 'lder-stadium', 'kn', 'lokalnamn',
+                 'ålder-stadium', 'kön', 'lokalnamn',
                  'ost', 'nord', 'noggrannhet',
                  'startdatum', 'slutdatum',
                  'starttid', 'sluttid',
                  'publik kommentar', 'intressant notering', 'privat kommentar',
-                 'ej terfunnen',
-                 'dlj fyndet t.o.m.',
-                 'andrahand', 'osker artbestmning', 'ospontan',
+                 'ej återfunnen',
+                 'dölj fyndet t.o.m.',
+                 'andrahand', 'osäker artbestämning', 'ospontan',
                  'biotop', 'biotop-beskrivning',
                  'art som substrat', 'art som substrat beskrivning',
                  'substrat', 'substrat-beskrivning',
                  'offentlig samling', 'privat samling', 'samlings-nummer',
-                 'artbestmd av', 'bestmningsdatum',
-                 'beskrivning artbestmning', 'bekrftad av',
-                 'med-observatr')
-    _synonym = Synonymous(['lder-stadium', 'stadium'],
+                 'artbestämd av', 'bestämningsdatum',
+                 'beskrivning artbestämning', 'bekräftad av',
+                 'med-observatör')
+    _synonym = Synonymous(['ålder-stadium', 'stadium'],
                           ['ost', 'ostkoordinat', 'ostkoordinat/longitud'],
                           ['nord', 'nordkoordinat', 'nordkoordinat/latitud'],
                           ['publik kommentar', 'kommentar'],
-                          ['ej terfunnen', 'ej funnen'],
+                          ['ej återfunnen', 'ej funnen'],
                           ['andrahand', 'andrahandsuppgift'],
-                          ['osker artbestmning', 'osker bestmning'],
-                          ['ospontan', 'utplanterad eller infrd'],
+                          ['osäker artbestämning', 'osäker bestämning'],
+                          ['ospontan', 'utplanterad eller införd'],
                           ['biotop', 'biotop - lista'],
                           ['biotop-beskrivning', 'biotopbeskrivning', 'biotop - text'],
-                          ['art som substrat', 'trdslag - lista', 'trdslag'],
-                          ['art som substrat beskrivning', 'trdslag - text'],
+                          ['art som substrat', 'trädslag - lista', 'trädslag'],
+                          ['art som substrat beskrivning', 'trädslag - text'],
                           ['substrat', 'substrat - lista'],
                           ['substrat-beskrivning', 'substratbeskrivning', 'substrat - text'],
                           ['samlings-nummer', 'samlingsnummer', 'accessionsnr'],
-                          ['artbestmd av', 'det/conf'],
-                          ['med-observatr', 'medobs', 'medobservatr'])
+                          ['artbestämd av', 'det/conf'],
+                          ['med-observatör', 'medobs', 'medobservatör'])
     _extension = ('koordinat',
-                  'dlj', 'skydda lokalangivelse',
+                  'dölj', 'skydda lokalangivelse',
                   'antal substrat', 'samling',
-                  'rapportera till rrk', 'underskt i mikroskop', 'syfte',
-                  'floravktarlokal', 'obsid')
-    _unsupptd  = ('dlj', 'skydda lokalangivelse',
+                  'rapportera till rrk', 'undersökt i mikroskop', 'syfte',
+                  'floraväktarlokal', 'obsid')
+    _unsupptd  = ('dölj', 'skydda lokalangivelse',
                   'antal substrat', 'samling',
-                  'rapportera till rrk', 'underskt i mikroskop', 'syfte',
-                  'floravktarlokal', 'obsid')
-    _binary    = ('ej terfunnen', 'andrahand', 'osker artbestmning',
-                  'ospontan', 'intressant notering', 'dlj', 'skydda lokalangivelse',
-                  'rapportera till rrk', 'underskt i mikroskop')
-    _repeatable = ('med-observatr', )
-
-    _enhet = Synonymous(['plantor/tuvor', 'plantor', 'tuvor', 'buskar', 'trd',
+                  'rapportera till rrk', 'undersökt i mikroskop', 'syfte',
+                  'floraväktarlokal', 'obsid')
+    _binary    = ('ej återfunnen', 'andrahand', 'osäker artbestämning',
+                  'ospontan', 'intressant notering', 'dölj', 'skydda lokalangivelse',
+                  'rapportera till rrk', 'undersökt i mikroskop')
+    _repeatable = ('med-observatör', )
+
+    _enhet = Synonymous(['plantor/tuvor', 'plantor', 'tuvor', 'buskar', 'träd',
                          'planta', 'tuva', 'buske'],
-                        ['stjlkar/strn', 'stjlkar', 'strn', 'stnglar', 'skott',
-                         'stjlk', 'str', 'stngel'],
-                        ['m2', 'm'],
-                        ['dm2', 'dm'],
-                        ['cm2', 'cm'])
+                        ['stjälkar/strån', 'stjälkar', 'strån', 'stänglar', 'skott',
+                         'stjälk', 'strå', 'stängel'],
+                        ['m2', 'm²'],
+                        ['dm2', 'dm²'],
+                        ['cm2', 'cm²'])
     _substrat = Synonymous()
     _biotop = Synonymous()
     _tree = Synonymous()
@@ -148,28 +148,28 @@ class Record(object):
                           ['Fullt utvecklade blad'],
                           ['Blomknopp'],
                           ['Blomning'],
-                          ['verblommad'],
+                          ['Överblommad'],
                           ['I frukt'],
-                          ['Frukt-/frspridning'],
-                          ['Gulnande lv/blad'],
-                          ['Bladfllning, vissnar'],
-                          ['Vinterstndare'])
+                          ['Frukt-/fröspridning'],
+                          ['Gulnande löv/blad'],
+                          ['Bladfällning, vissnar'],
+                          ['Vinterståndare'])
     _samling = Synonymous(['Eget'],
                           ['Annat'],
                           ['Lund-Botaniska/Zoologiska museet'],
-                          ['Gteborgs naturhistoriska museum (GNM)'],
-                          ['Gteborg-Herbarium GB'],
+                          ['Göteborgs naturhistoriska museum (GNM)'],
+                          ['Göteborg-Herbarium GB'],
                           ['Stockholm-Naturhistoriska riksmuseet'],
                           ['Uppsala-Evolutionsmuseet'],
                           ['Uppsala-SLU'],
-                          ['Ume-Herbarium UME'],
+                          ['Umeå-Herbarium UME'],
                           ['Oskarshamn-Herbarium OHN'],
                           ['Visby-Herbarium VI'],
-                          ['rebro-Herbarium OREB'],
+                          ['Örebro-Herbarium OREB'],
                           ['Lycksele skogsmuseum'],
                           ['Regionmuseet Kristianstad'],
                           ['Helsingfors'],
-                          ['Kpenhamn'],
+                          ['Köpenhamn'],
                           ['Oslo'])
 
     class Re:
@@ -244,7 +244,7 @@ class Record(object):
             if v.has_key(k):
                 self._log.warning('ignoring superfluous "%s: %s"' % (k, v[k]))
         elif not v.has_key(k):
-            if not v.has_key('floravktarlokal'):
+            if not v.has_key('floraväktarlokal'):
                 self._log.warning('no coordinate info present')
         else:
             m = self.Re.rt90.match(v[k])
@@ -263,22 +263,22 @@ class Record(object):
                 v[b] = v[a]
 
         # canonize various multi-selection fields
-        self._canonize('lder-stadium', self._stadium)
+        self._canonize('ålder-stadium', self._stadium)
         self._canonize('noggrannhet', self._noggrannhet)
         self._canonize('samling', self._samling)
 
         # canonize those crazy descriptive fields
         self._canonize_trinity('substrat - lista', 'substrat - text', 'substrat', self._substrat)
         self._canonize_trinity('biotop - lista', 'biotop - text', 'biotop', self._biotop)
-        self._canonize_trinity('trdslag - lista', 'trdslag - text', 'trdslag', self._tree)
+        self._canonize_trinity('trädslag - lista', 'trädslag - text', 'trädslag', self._tree)
 
         # canonize the binary fields
         for k in self._binary:
             if v.get(k):
                 v[k] = 'X'
 
-        # clean away stuff incompatible with floravktarlokal
-        if False and v.has_key('floravktarlokal'):
+        # clean away stuff incompatible with floraväktarlokal
+        if False and v.has_key('floraväktarlokal'):
             for k in ('lokalnamn',
                       'nordkoordinat', 'ostkoordinat',
                       'noggrannhet'):
@@ -288,7 +288,7 @@ class Record(object):
         for k in ('artnamn', 'startdatum', 'slutdatum'):
             if not v.has_key(k):
                 self._log.warning('mandatory field "%s" missing' % k)
-        if False and v.has_key('floravktarlokal'):
+        if False and v.has_key('floraväktarlokal'):
             return
         for k in ('lokalnamn', 'nord', 'ost', 'noggrannhet'):
             if not v.has_key(k):
@@ -305,7 +305,7 @@ class Record(object):
                 self._v[field] = ss
 
     def _canonize_trinity(self, list, text, both, synonyms):
-        """Helper for the substrat/biotop/trdslag fields
+        """Helper for the substrat/biotop/trädslag fields
         """
         v = self._v
         s = v.get(list)
@@ -462,7 +462,7 @@ if __name__ == "__main__":
             elif opt=='--version':
                 groblad, ver = cvs_says()
                 print '%s, part of %s %s' % (prog, groblad, ver)
-                print 'Copyright (c) 2011, 2013 Jrgen Grahn. All rights reserved.'
+                print 'Copyright (c) 2011, 2013 Jörgen Grahn. All rights reserved.'
                 sys.exit(0)
     except getopt.GetoptError, s:
         print >>sys.stderr, s
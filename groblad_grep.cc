@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1999--2001, 2013, 2018 Jrgen Grahn
+ * Copyright (c) 1999--2001, 2013, 2018 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -26,13 +26,19 @@
  */
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include <getopt.h>
 
 #include "files...h"
 #include "taxa.h"
-#include "excursion.h"
 #include "regex.h"
+#include "fixed.h"
+#include "grep.h"
 
 
 extern "C" {
@@ -41,44 +47,18 @@ extern "C" {
 }
 
 
-namespace {
-
-    /**
-     * True if 'ex' matches 're' in some way, or if it contains
-     * one of 'taxa'.
-     */
-    template<class Regex>
-    bool matches(const Regex& re, const Excursion& ex,
-		 const std::vector<TaxonId>& taxa)
-    {
-	if(ex.has_one(taxa)) return true;
-	for(Excursion::Headers::const_iterator i = ex.hbegin();
-	    i != ex.hend();
-	    i++) {
-	    if(re.match(i->value)) return true;
-	}
-	for(Excursion::Sightings::const_iterator i = ex.sbegin();
-	    i != ex.send();
-	    i++) {
-	    if(re.match(i->name)) return true;
-	    if(re.match(i->comment)) return true;
-	}
-
-	return false;
-    }
-}
-
-
 int main(int argc, char ** argv)
 {
     using std::string;
 
     const string prog = argv[0];
     const string usage = string("usage: ")
-	+ prog + " [-s species] [-v] pattern file ...\n"
+	+ prog + " [-s species] [-j jobs] [-F] [-t] [-v] pattern file ...\n"
+	"       "
+	+ prog + " [-s species] [-j jobs] [-F] [-t] [-v] -f patterns file ...\n"
 	"       "
 	+ prog + " --version";
-    const char optstring[] = "vs:";
+    const char optstring[] = "Ftvf:s:j:";
     const struct option long_options[] = {
 	{"version", 0, 0, 'V'},
 	{"help", 0, 0, 'H'},
@@ -89,23 +69,39 @@ int main(int argc, char ** argv)
     std::cout.sync_with_stdio(false);
 
     std::string species_file = Taxa::species_file();
+    std::string pattern_file;
+    bool fixed = false;
     bool invert = false;
+    bool taxa_only = false;
+    unsigned jobs = 1;
 
     int ch;
     while((ch = getopt_long(argc, argv,
 			    optstring,
 			    &long_options[0], 0)) != -1) {
 	switch(ch) {
+	case 'F':
+	    fixed = true;
+	    break;
+	case 'f':
+	    pattern_file = optarg;
+	    break;
+	case 't':
+	    taxa_only = true;
+	    break;
 	case 'v':
 	    invert = true;
 	    break;
 	case 's':
 	    species_file = optarg;
 	    break;
+	case 'j':
+	    jobs = std::max(1, std::atoi(optarg));
+	    break;
 	case 'V':
 	    std::cout << prog << ", part of "
 		      << groblad_name() << ' ' << groblad_version() << "\n"
-		      << "Copyright (c) 2013, 2018 Jrgen Grahn\n";
+		      << "Copyright (c) 2013, 2018 Jörgen Grahn\n";
 	    return 0;
 	    break;
 	case 'H':
@@ -122,18 +118,62 @@ int main(int argc, char ** argv)
 	}
     }
 
-    if(optind==argc) {
+    std::vector<grep::Pattern> pv;
+    if(!pattern_file.empty()) {
+	std::ifstream is(pattern_file);
+	if(!is) {
+	    std::cerr << "error: cannot open '" << pattern_file
+		      << "' for reading: " << std::strerror(errno) << '\n';
+	    return 1;
+	}
+	if(!grep::patterns(pv, is, pattern_file, std::cerr)) return 1;
+    }
+    else if(optind!=argc) {
+	pv.emplace_back("-", argv[optind++]);
+    }
+    else {
 	std::cerr << usage << '\n';
 	return 1;
     }
 
-    const string rest = argv[optind++];
-    const Regex re(rest);
-    if(re.bad()) {
-	std::cerr << prog << ": error in \""
-		  << rest << "\": "
-		  << re.error() << '\n';
-	return 1;
+    std::vector<std::unique_ptr<Regex>> re;
+    std::vector<std::unique_ptr<Fixed>> fre;
+    for(const auto& p : pv) {
+	if(fixed) {
+	    fre.emplace_back(new Fixed(p.second));
+	    continue;
+	}
+	re.emplace_back(new Regex(p.second));
+	if(re.back()->bad()) {
+	    std::cerr << prog << ": error in \""
+		      << p.second << "\": "
+		      << re.back()->error() << '\n';
+	    return 1;
+	}
+    }
+
+    std::vector<std::string> names;
+    std::vector<size_t> dest;
+    for(const auto& p : pv) {
+	const auto i = std::find(names.begin(), names.end(), p.first);
+	dest.push_back(i - names.begin());
+	if(i==names.end()) names.push_back(p.first);
+    }
+
+    std::vector<std::unique_ptr<std::ofstream>> files_out(names.size());
+    std::vector<grep::Output> out;
+    for(size_t i = 0; i < names.size(); i++) {
+	if(names[i]=="-") {
+	    out.emplace_back(std::cout);
+	    continue;
+	}
+	files_out[i].reset(new std::ofstream(names[i]));
+	if(!*files_out[i]) {
+	    std::cerr << "error: cannot open '" << names[i]
+		      << "' for writing: " << std::strerror(errno) << '\n';
+	    return 1;
+	}
+	out.emplace_back(*files_out[i]);
     }
 
     Files files(argv+optind, argv+argc);
@@ -144,19 +184,23 @@ int main(int argc, char ** argv)
                   << "' for reading: " << std::strerror(errno) << '\n';
         return 1;
     }
-    Taxa taxa(species, std::cerr);
+    Taxa taxa(species_file, species, std::cerr);
     species.close();
-    const std::vector<TaxonId> matchtx = taxa.match(re);
 
-    Excursion ex;
-    unsigned n = 0;
-    while(get(files, std::cerr, taxa, ex)) {
+    if(fixed) {
+	grep::grep(fre, dest, out, files, taxa, jobs, taxa_only, invert);
+    }
+    else {
+	grep::grep(re, dest, out, files, taxa, jobs, taxa_only, invert);
+    }
 
-	if(invert ^ matches(re, ex, matchtx)) {
-	    if(n++) std::cout << '\n';
-	    std::cout << ex;
+    for(size_t i = 0; i < names.size(); i++) {
+	if(!files_out[i]) continue;
+	files_out[i]->close();
+	if(!*files_out[i]) {
+	    std::cerr << "error: failed to write '" << names[i] << "'\n";
+	    return 1;
 	}
     }
-
     return 0;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2014, 2018, 2020 Jrgen Grahn
+ * Copyright (c) 2013, 2014, 2018, 2020 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -25,17 +25,36 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <string>
-#include <list>
+#include <deque>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <stdexcept>
 #include <cstring>
+#include <cstdlib>
 #include <stdio.h>
 #include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include "files...h"
 #include "taxa.h"
 #include "excursion.h"
 #include "coordinate.h"
+#include "parser.h"
+#include "workers.h"
+#include "spill.h"
+#include "mmap.h"
+#include "md5pp.h"
+#include "fieldview.h"
+#include "book.h"
+#include "cooccurrence.h"
 
 
 extern "C" {
@@ -47,59 +66,249 @@ extern "C" {
 
 namespace {
 
-    struct contains {
-	explicit contains(const Taxon& sp) : id(sp.id) {}
-	explicit contains(const TaxonId& id) : id(id) {}
-	const TaxonId id;
-	template<class T>
-	bool operator() (const T& t) const { return t.contains(id); }
+    /**
+     * Writing to 'os', but with the formatting done by 'workers'
+     * into buffers, up to 2*'jobs' at a time, which are written in
+     * the order they were queued.  Without workers, it's all done
+     * right away, by the caller.
+     */
+    class Output {
+    public:
+	typedef std::function<void (std::ostream&)> Task;
+
+	Output(std::ostream& os, Workers* workers, unsigned jobs);
+	~Output() { flush(); }
+	void queue(const Task& task);
+	void flush();
+
+    private:
+	Output(const Output&);
+	Output& operator= (const Output&);
+
+	void pop();
+
+	struct Part {
+	    std::ostringstream buf;
+	    std::future<void> done;
+	};
+
+	std::ostream& os;
+	Workers* const workers;
+	const unsigned jobs;
+	std::deque<std::unique_ptr<Part>> parts;
     };
 
-    typedef std::list<Excursion> Book;
+    Output::Output(std::ostream& os, Workers* workers,
+		   const unsigned jobs)
+	: os(os),
+	  workers(workers),
+	  jobs(jobs)
+    {}
+
+    void Output::queue(const Task& task)
+    {
+	if(!workers) {
+	    task(os);
+	    return;
+	}
+	while(parts.size() >= 2*jobs) pop();
+
+	std::unique_ptr<Part> part(new Part);
+	std::ostream* const buf = &part->buf;
+	part->done = workers->submit([task, buf] { task(*buf); });
+	parts.push_back(std::move(part));
+    }
+
+    void Output::flush()
+    {
+	while(!parts.empty()) pop();
+    }
+
+    /**
+     * Helper. Wait for the oldest part, and write it.
+     */
+    void Output::pop()
+    {
+	Part& part = *parts.front();
+	part.done.get();
+	os << part.buf.str();
+	parts.pop_front();
+    }
 
-    Book filter(const Book& src, const Taxon& sp)
+    /**
+     * For each TaxonId, the excursions in 'book' with that taxon
+     * in them, in order -- found in one pass over the book, without
+     * looking at its text.
+     */
+    std::vector<std::vector<unsigned>> group(const Book& book,
+					     const Taxa& spp)
     {
-	Book acc;
-	std::copy_if(src.begin(), src.end(),
-		     std::back_insert_iterator<Book>(acc),
-		     contains(sp));
+	const size_t n = spp.end() - spp.begin() + 1;
+	std::vector<std::vector<unsigned>> acc(n);
+	for(unsigned i = 0; i < book.size(); i++) {
+	    const Book::Entry ex = book[i];
+	    for(auto j = ex.tbegin(); j != ex.tend(); j++) {
+		acc[j->val].push_back(i);
+	    }
+	}
 	return acc;
     }
 
+    template<class Ex>
     void troff(std::ostream& os,
-	       const Excursion& ex)
+	       const Ex& ex)
     {
-	os << ex.find_header("place") << '\n'
-	   << "\\s-2(" << ex.find_header("coordinate") << ")\\s0.\n"
-	   << ex.find_header("observers")
-	   << "\\~" << ex.find_header("date") << ".\n";
+	os << ex.header(header::PLACE) << '\n'
+	   << "\\s-2(" << ex.header(header::COORDINATE) << ")\\s0.\n"
+	   << ex.header(header::OBSERVERS)
+	   << "\\~" << ex.header(header::DATE) << ".\n";
     }
 
-    void troff(std::ostream& os, const Book& book, const Taxa& spp)
+    void troff(std::ostream& os, const Taxon& sp)
     {
-	for(const Taxon& sp : spp) {
-	    const Book b = filter(book, sp);
-	    if(b.empty()) continue;
-
-	    os << ".\n"
-	       << ".XP\n"
-	       << ".B \"" << sp.name << "\"\n";
-	    if(!sp.latin.empty()) {
-		os << ".I \"" << sp.latin << "\" :\n";
-	    }
+	os << ".\n"
+	   << ".XP\n"
+	   << ".B \"" << sp.name << "\"\n";
+	if(!sp.latin.empty()) {
+	    os << ".I \"" << sp.latin << "\" :\n";
+	}
+    }
 
-	    for(Book::const_iterator i=b.begin(); i!=b.end(); i++) {
-		if(i!=b.begin()) os << "\\(em\n";
-		troff(os, *i);
-	    }
+    void troff(std::ostream& os, const Taxon& sp,
+	       const Book& book, const std::vector<unsigned>& b)
+    {
+	troff(os, sp);
+	for(auto i=b.begin(); i!=b.end(); i++) {
+	    if(i!=b.begin()) os << "\\(em\n";
+	    troff(os, book[*i]);
+	}
+    }
+
+    /**
+     * The --ms report, with the taxa formatted a few hundred at a
+     * time by 'out'.
+     */
+    void troff(Output& out, const Book& book, const Taxa& spp)
+    {
+	typedef std::vector<std::vector<unsigned>> Groups;
+	const Groups groups = group(book, spp);
+	const Groups* const g = &groups;
+	const Book* const bk = &book;
+
+	const size_t slice = 256;
+	for(auto i = spp.begin(); i != spp.end(); ) {
+	    const auto a = i;
+	    i += std::min(slice, size_t(spp.end() - i));
+	    out.queue([g, bk, a, i] (std::ostream& os) {
+			  for(auto j = a; j != i; j++) {
+			      const auto& b = (*g)[j->id.val];
+			      if(!b.empty()) troff(os, *j, *bk, b);
+			  }
+		      });
+	}
+	out.flush();
+    }
+
+    /**
+     * The --together report: for each taxon in 'book', in taxonomic
+     * order, the taxa seen together with it, most common first.
+     * One line per pair: the two names, how many excursions they're
+     * both in, and that as a fraction of the excursions with either
+     * one in it.  The rows are counted and formatted a few hundred
+     * taxa at a time by 'out'.
+     */
+    void cooccurrence(Output& out, const Book& book, const Taxa& spp)
+    {
+	const Cooccurrence co(book, spp.end() - spp.begin() + 1);
+	const Cooccurrence* const c = &co;
+	const Taxa* const s = &spp;
+
+	const size_t slice = 256;
+	for(auto i = spp.begin(); i != spp.end(); ) {
+	    const auto a = i;
+	    i += std::min(slice, size_t(spp.end() - i));
+	    out.queue([c, s, a, i] (std::ostream& os) {
+			  std::vector<unsigned> scratch;
+			  std::vector<Cooccurrence::Pair> row;
+			  char buf[20];
+			  for(auto j = a; j != i; j++) {
+			      c->row(j->id, scratch, row);
+			      const unsigned n = c->count(j->id);
+			      for(const auto& p : row) {
+				  const unsigned m = c->count(p.sp);
+				  std::snprintf(buf, sizeof buf, "%.3f",
+						double(p.n) / (n + m - p.n));
+				  os << j->name << '\t'
+				     << (*s)[p.sp].name << '\t'
+				     << p.n << '\t'
+				     << buf << '\n';
+			      }
+			  }
+		      });
 	}
+	out.flush();
     }
 
-    std::string join(const std::string& s)
+    /**
+     * The --ms report for a book which may not fit in memory.  Each
+     * excursion from 'parser' is formatted once, into a temporary
+     * file.  Which taxa are in which of them is sorted by a Spill
+     * with the memory 'budget'; then the formatted excursions are
+     * picked from the file in that order.
+     */
+    void troff(std::ostream& os, Parser& parser, const Taxa& spp,
+	       const size_t budget)
     {
-	std::string t = s;
-	std::replace(t.begin(), t.end(), '\n', ' ');
-	return t;
+	std::unique_ptr<FILE, int (*)(FILE*)> f(Spill::temporary(), std::fclose);
+	Spill spill(budget);
+
+	Excursion ex;
+	std::vector<unsigned> ids;
+	std::ostringstream buf;
+	uint64_t offset = 0;
+	while(parser.get(ex)) {
+	    ids.clear();
+	    for(auto i = ex.sbegin(); i != ex.send(); i++) {
+		ids.push_back(i->sp.val);
+	    }
+	    if(ids.empty()) continue;
+	    std::sort(ids.begin(), ids.end());
+	    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+	    buf.str("");
+	    troff(buf, ex);
+	    const std::string s = buf.str();
+	    const uint32_t len = s.size();
+	    if(std::fwrite(&len, sizeof len, 1, f.get()) != 1 ||
+	       std::fwrite(s.data(), 1, len, f.get()) != len) {
+		throw std::runtime_error("writing temporary file: "
+					 + std::string(std::strerror(errno)));
+	    }
+	    for(unsigned id : ids) spill.add(id, offset);
+	    offset += sizeof len + len;
+	}
+
+	if(std::fflush(f.get())) {
+	    throw std::runtime_error("writing temporary file: "
+				     + std::string(std::strerror(errno)));
+	}
+	const Mmap text(fileno(f.get()));
+
+	unsigned id;
+	unsigned prev = 0;
+	uint64_t at;
+	while(spill.get(id, at)) {
+	    if(id != prev) {
+		troff(os, spp[TaxonId(id)]);
+		prev = id;
+	    }
+	    else {
+		os << "\\(em\n";
+	    }
+	    uint32_t len;
+	    std::memcpy(&len, text.begin() + at, sizeof len);
+	    os.write(text.begin() + at + sizeof len, len);
+	}
     }
 
     template <class Iter>
@@ -120,76 +329,103 @@ namespace {
 	return join_to(os, delim, begin(v), end(v));
     }
 
+    /**
+     * Write [a, b) with newlines as spaces, like join(s) would.
+     */
+    void unfold(std::ostream& os, const char* a, const char* const b)
+    {
+	while(a!=b) {
+	    const char* c = std::find(a, b, '\n');
+	    os.write(a, c - a);
+	    if(c==b) break;
+	    os << ' ';
+	    a = c + 1;
+	}
+    }
+
+    void unfold(std::ostream& os, const std::string& s)
+    {
+	unfold(os, s.data(), s.data() + s.size());
+    }
+
+    void unfold(std::ostream& os, const FieldView::Text& s)
+    {
+	if(s.simple()) return unfold(os, s.a, s.a + s.n);
+	unfold(os, s.str());
+    }
+
+    std::string str(const std::string& s) { return s; }
+    std::string str(const FieldView::Text& s) { return s.str(); }
+
+    bool prefer_latin = true;
+
+    /**
+     * Printing the rows for the sightings in an excursion (or a
+     * view of one).  Everything but the taxon and the comment is
+     * the same in all of them, so that part is formatted just once.
+     */
+    template<class Ex, class Spp>
     struct exrow {
-	exrow(std::ostream& os, const Taxa& spp, const Excursion& ex);
-	void operator() (const Excursion::Sighting&) const;
+	exrow(std::ostream& os, const Spp& spp, const Ex& ex);
+	void operator() (const typename Ex::Sighting&) const;
 	std::ostream& os;
-	const Taxa& spp;
-	const Excursion& ex;
-	const std::string place;
-	const std::string& date;
-	const std::string& coordinate;
-	const Coordinate coord;
-
-	static bool prefer_latin;
+	const Spp& spp;
+	std::string middle;
     };
 
-    bool exrow::prefer_latin = true;
-
-    exrow::exrow(std::ostream& os, const Taxa& spp, const Excursion& ex)
+    template<class Ex, class Spp>
+    exrow<Ex, Spp>::exrow(std::ostream& os, const Spp& spp, const Ex& ex)
 	: os(os),
-	  spp(spp),
-	  ex(ex),
-	  place(join(ex.find_header("place"))),
-	  date(ex.find_header("date")),
-	  coordinate(ex.find_header("coordinate")),
-	  coord(&coordinate[0], &coordinate[0] + coordinate.size())
-    {}
-
-    void exrow::operator() (const Excursion::Sighting& s) const
+	  spp(spp)
     {
-	const Taxon sp = spp[s.sp];
-	const auto name = (prefer_latin && !sp.latin.empty()) ? sp.latin : sp.name;
-
-	auto ifv = [this] (unsigned n) {
+	const std::string date = str(ex.header(header::DATE));
+	const Coordinate& coord = ex.coordinate;
+	auto ifv = [&coord] (unsigned n) {
 		       if (!coord.valid()) n = 0;
 		       return std::to_string(n);
 		   };
 
-	join(os, "\t", {name,
-			"",
-			"",
-			"",
-			"",
-			"",
-			"",
-			"",
-			"",
-			place,
-			ifv(coord.east),
-			ifv(coord.north),
-			ifv(coord.resolution),
-			date,
-			date,
-			join(s.comment)})
-	    << '\n';
-    }
-
-    void tbl(std::ostream& os, const Book& book, const Taxa& spp)
+	std::ostringstream oss;
+	oss << "\t\t\t\t\t\t\t\t\t";
+	unfold(oss, ex.header(header::PLACE));
+	oss << '\t' << ifv(coord.east)
+	    << '\t' << ifv(coord.north)
+	    << '\t' << ifv(coord.resolution)
+	    << '\t' << date
+	    << '\t' << date
+	    << '\t';
+	middle = oss.str();
+    }
+
+    template<class Ex, class Spp>
+    void exrow<Ex, Spp>::operator() (const typename Ex::Sighting& s) const
+    {
+	const Taxon& sp = spp[s.sp];
+	const std::string& name = (prefer_latin && !sp.latin.empty()) ? sp.latin : sp.name;
+	os << name << middle;
+	unfold(os, s.comment);
+	os << '\n';
+    }
+
+    /**
+     * The start of the --svalan table. Then each excursion is
+     * formatted as it's read, by tbl(os, spp, ex).
+     */
+    void tbl(std::ostream& os)
     {
 	os << ".TS H\n"
 	   << "allbox;\n"
 	   << "lrrrrrllllrrrlll.\n";
 
 	join(os, "\t", {"Artnamn",
-			"Ej terfunnen",
-			"Osker artbestmning",
+			"Ej återfunnen",
+			"Osäker artbestämning",
 			"Ospontan",
 			"Andrahand",
 			"Antal",
 			"Enhet",
-			"lder-Stadium",
-			"Kn",
+			"Ålder-Stadium",
+			"Kön",
 			"Lokalnamn",
 			"Ost",
 			"Nord",
@@ -199,10 +435,259 @@ namespace {
 			"Publik kommentar"})
 	    << '\n'
 	    << ".TH\n";
+    }
 
-	for(const Excursion& ex : book) {
-	    std::for_each(ex.sbegin(), ex.send(), exrow(os, spp, ex));
+    template<class Ex, class Spp>
+    void tbl(std::ostream& os, const Spp& spp, const Ex& ex)
+    {
+	std::for_each(ex.sbegin(), ex.send(), exrow<Ex, Spp>(os, spp, ex));
+    }
+
+    /**
+     * Excursions to format as --svalan rows on some other thread,
+     * and the taxa to name them with: those in 'spp', which stays
+     * put, and copies of the ones the parser added after it.
+     */
+    struct Batch {
+	explicit Batch(const Taxa& spp) : spp(spp) {}
+	const Taxon& operator[] (TaxonId id) const;
+	const Taxa& spp;
+	std::vector<Taxon> invented;
+	std::vector<Excursion> v;
+    };
+
+    const Taxon& Batch::operator[] (const TaxonId id) const
+    {
+	const size_t known = spp.end() - spp.begin();
+	if(id.val <= known) return spp[id];
+	return invented.at(id.val - known - 1);
+    }
+
+    /**
+     * The --svalan rows, as the excursions come out of 'parser'.
+     * With more than one job, they're formatted in Batches, on the
+     * parser's threads.  A batch which mentions taxa the parser has
+     * invented carries its own copies of them, since 'spp' may grow
+     * meanwhile.
+     */
+    void tbl(Output& out, Parser& parser, const Taxa& spp)
+    {
+	const Taxa* const initial = parser.initial();
+	if(!initial) {
+	    FieldView ex;
+	    while(parser.get(ex)) {
+		out.queue([&spp, &ex] (std::ostream& os) {
+			      tbl(os, spp, ex);
+			  });
+	    }
+	    return;
+	}
+
+	Excursion ex;
+	const size_t batch_size = 256;
+	const size_t known = initial->end() - initial->begin();
+	bool more = true;
+	while(more) {
+	    std::shared_ptr<Batch> batch(new Batch(*initial));
+	    std::vector<Excursion>& v = batch->v;
+	    v.reserve(batch_size);
+	    while(v.size() < batch_size && (more = parser.get(ex))) {
+		for(auto i = ex.sbegin(); i != ex.send(); i++) {
+		    const size_t n = i->sp.val;
+		    auto& invented = batch->invented;
+		    while(n > known + invented.size()) {
+			invented.push_back(spp.begin()[known + invented.size()]);
+		    }
+		}
+		v.emplace_back();
+		v.back().swap(ex);
+	    }
+	    if(v.empty()) break;
+
+	    out.queue([batch] (std::ostream& os) {
+			  for(const Excursion& ex : batch->v) {
+			      tbl(os, *batch, ex);
+			  }
+		      });
+	}
+	out.flush();
+    }
+
+    /**
+     * How much of a book has been exported already: its first
+     * 'length' octets, which were 'lines' lines.  Of those,
+     * [start, length) is the last excursion exported (with anything
+     * before it since the one before that), with MD5 'digest'.
+     * The book had size, inode and modification time 'stamp' then.
+     */
+    struct Mark {
+	Mark() : length(0), lines(0), start(0) {}
+	size_t length;
+	unsigned lines;
+	size_t start;
+	std::string digest;
+	std::string stamp;
+    };
+
+    /**
+     * "size inode seconds.nanoseconds" for a book.
+     */
+    std::string stamp(const struct stat& st)
+    {
+	char buf[80];
+	std::snprintf(buf, sizeof buf, "%llu %llu %llu.%09lu",
+		      (unsigned long long)st.st_size,
+		      (unsigned long long)st.st_ino,
+		      (unsigned long long)st.st_mtim.tv_sec,
+		      (unsigned long)st.st_mtim.tv_nsec);
+	return buf;
+    }
+
+    /**
+     * The marks in a --since file, one line per book:
+     * "length lines start digest size inode mtime name".  No file
+     * means nothing has been exported yet.  An older form of the
+     * line, "length lines digest name", means a digest of all of
+     * it, and no stamp.
+     */
+    std::map<std::string, Mark> marks(const std::string& file)
+    {
+	std::map<std::string, Mark> acc;
+	std::ifstream is(file);
+	std::string s;
+	while(std::getline(is, s)) {
+	    std::istringstream iss(s);
+	    Mark m;
+	    std::string digest;
+	    if(!(iss >> m.length >> m.lines >> digest)) continue;
+	    if(digest.size()!=32) {
+		std::istringstream(digest) >> m.start;
+		std::string a, b, c;
+		if(!(iss >> digest >> a >> b >> c)) continue;
+		m.stamp = a + ' ' + b + ' ' + c;
+	    }
+	    if(digest!="-") m.digest = digest;
+	    std::string name;
+	    if(iss.get()==' ' && std::getline(iss, name)) {
+		acc[name] = m;
+	    }
 	}
+	return acc;
+    }
+
+    /**
+     * Replace the --since file with 'marks', or return false.
+     */
+    bool save(const std::string& file, const std::map<std::string, Mark>& marks)
+    {
+	const std::string tmp = file + ".tmp";
+	std::ofstream os(tmp);
+	for(const auto& item : marks) {
+	    const Mark& m = item.second;
+	    os << m.length << ' ' << m.lines << ' ' << m.start << ' '
+	       << (m.digest.empty() ? "-" : m.digest) << ' '
+	       << (m.stamp.empty() ? "- - -" : m.stamp) << ' '
+	       << item.first << '\n';
+	}
+	os.close();
+	if(!os || std::rename(tmp.c_str(), file.c_str())) {
+	    std::remove(tmp.c_str());
+	    return false;
+	}
+	return true;
+    }
+
+    std::string digest(const char* a, const size_t n)
+    {
+	md5::Ctx ctx;
+	ctx.update(a, n);
+	return ctx.digest().hex();
+    }
+
+    /**
+     * The --svalan rows for the excursions added to 'books' since
+     * the 'state' file was last updated -- then update it.  Only
+     * those parts are read, plus the last excursion exported from
+     * each book, to make sure it's still what was exported.  (Not
+     * even that, if the book looks untouched since.)
+     *
+     * A book is marked as exported up to its last complete
+     * excursion; anything after that is looked at again next time.
+     */
+    int since(const std::string& state, const std::vector<std::string>& books,
+	      Taxa& spp)
+    {
+	std::map<std::string, Mark> m = marks(state);
+	std::map<std::string, std::unique_ptr<Mmap>> open_books;
+	std::vector<Files::Segment> segments;
+
+	for(const std::string& name : books) {
+	    if(open_books.count(name)) continue;
+	    const int fd = open(name.c_str(), O_RDONLY);
+	    if(fd==-1) {
+		std::cerr << "error: cannot open '" << name
+			  << "' for reading: " << std::strerror(errno) << '\n';
+		return 1;
+	    }
+	    struct stat st;
+	    const bool stat_ok = !fstat(fd, &st);
+	    std::unique_ptr<Mmap> book(new Mmap(fd));
+	    close(fd);
+	    const char* const a = book->begin();
+
+	    Mark& mark = m[name];
+	    const bool untouched = stat_ok && mark.stamp==stamp(st);
+	    if(stat_ok) mark.stamp = stamp(st);
+	    const bool shrunk = mark.length > book->size() ||
+				mark.start > mark.length;
+	    if(shrunk || (mark.length && !untouched &&
+			  digest(a + mark.start,
+				 mark.length - mark.start) != mark.digest)) {
+		std::cerr << "error: '" << name << "' has changed since it was"
+			  << " exported; remove '" << state
+			  << "' to export it all again\n";
+		return 1;
+	    }
+
+	    if(mark.length < book->size()) {
+		segments.emplace_back(Files::Position(name, mark.lines + 1),
+				      a + mark.length, book->end(),
+				      mark.length);
+	    }
+	    open_books[name].swap(book);
+	}
+
+	tbl(std::cout);
+	std::map<std::string, bool> exported;
+	if(!segments.empty()) {
+	    Files is(segments);
+	    FieldView ex;
+	    while(get(is, std::cerr, spp, ex)) {
+		tbl(std::cout, spp, ex);
+		const std::string& name = is.position().file;
+		Mark& mark = m[name];
+		mark.start = mark.length;
+		mark.length = is.offset();
+		mark.lines = is.position().line;
+		exported[name] = true;
+	    }
+	}
+
+	std::cout.flush();
+	if(!std::cout) return 1;
+
+	for(const auto& item : exported) {
+	    const Mmap& book = *open_books[item.first];
+	    Mark& mark = m[item.first];
+	    mark.digest = digest(book.begin() + mark.start,
+				 mark.length - mark.start);
+	}
+	if(!save(state, m)) {
+	    std::cerr << "error: cannot write '" << state
+		      << "': " << std::strerror(errno) << '\n';
+	    return 1;
+	}
+	return 0;
     }
 }
 
@@ -213,20 +698,26 @@ int main(int argc, char ** argv)
 
     const string prog = argv[0];
     const string usage = string("usage: ")
-	+ prog + " [-s species] [--ms] file ...\n"
+	+ prog + " [-s species] [-j jobs] [-m megabytes] [--ms] file ...\n"
+	"       "
+	+ prog + " [-s species] [-j jobs] --svalan file ...\n"
+	"       "
+	+ prog + " [-s species] [-j jobs] --svalan-sv file ...\n"
 	"       "
-	+ prog + " [-s species] --svalan file ...\n"
+	+ prog + " [-s species] [-j jobs] --together file ...\n"
 	"       "
-	+ prog + " [-s species] --svalan-sv file ...\n"
+	+ prog + " [-s species] --svalan[-sv] --since state book ...\n"
 	"       "
 	+ prog + " --version\n"
 	"       "
 	+ prog + " --help";
-    const char optstring[] = "s:";
+    const char optstring[] = "s:j:m:";
     const struct option long_options[] = {
 	{"ms", 0, 0, 'M'},
 	{"svalan", 0, 0, 'S'},
 	{"svalan-sv", 0, 0, 'Z'},
+	{"together", 0, 0, 'T'},
+	{"since", 1, 0, 'I'},
 	{"version", 0, 0, 'V'},
 	{"help", 0, 0, 'H'},
 	{0, 0, 0, 0}
@@ -237,6 +728,10 @@ int main(int argc, char ** argv)
 
     std::string species_file = Taxa::species_file();
     bool generate_troff = true;
+    bool together = false;
+    unsigned jobs = 1;
+    size_t budget = 0;
+    std::string state;
 
     int ch;
     while((ch = getopt_long(argc, argv,
@@ -244,16 +739,27 @@ int main(int argc, char ** argv)
 			    &long_options[0], 0)) != -1) {
 	switch(ch) {
 	case 's': species_file = optarg; break;
-	case 'M': generate_troff = true; break;
-	case 'S': generate_troff = false; break;
+	case 'j': jobs = std::max(1, std::atoi(optarg)); break;
+	case 'm': budget = size_t(std::max(1, std::atoi(optarg))) << 20; break;
+	case 'I': state = optarg; break;
+	case 'M':
+	    generate_troff = true;
+	    together = false;
+	    break;
+	case 'S':
+	    generate_troff = false;
+	    together = false;
+	    break;
 	case 'Z':
 	    generate_troff = false;
-	    exrow::prefer_latin = false;
+	    together = false;
+	    prefer_latin = false;
 	    break;
+	case 'T': together = true; break;
 	case 'V':
 	    std::cout << prog << ", part of "
 		      << groblad_name() << ' ' << groblad_version() << "\n"
-		      << "Copyright (c) 2004 - 2020 Jrgen Grahn\n";
+		      << "Copyright (c) 2004 - 2020 Jörgen Grahn\n";
 	    return 0;
 	    break;
 	case 'H':
@@ -270,6 +776,15 @@ int main(int argc, char ** argv)
 	}
     }
 
+    const std::vector<std::string> books(argv+optind, argv+argc);
+    if(!state.empty()) {
+	const bool named = std::find(books.begin(), books.end(), "-")==books.end();
+	if(generate_troff || together || books.empty() || !named) {
+	    std::cerr << usage << '\n';
+	    return 1;
+	}
+    }
+
     Files files(argv+optind, argv+argc);
 
     std::ifstream species(species_file);
@@ -278,22 +793,41 @@ int main(int argc, char ** argv)
                   << "' for reading: " << std::strerror(errno) << '\n';
         return 1;
     }
-    Taxa taxa(species, std::cerr);
+    Taxa taxa(species_file, species, std::cerr);
     species.close();
 
-    std::list<Excursion> book;
-    const Excursion nil;
-    Excursion ex;
-    while(get(files, std::cerr, taxa, ex)) {
-	book.push_back(nil);
-	book.back().swap(ex);
+    if(!state.empty()) return since(state, books, taxa);
+
+    Parser parser(files, std::cerr, taxa, jobs);
+    Output out(std::cout, parser.pool(), jobs);
+
+    if(!generate_troff && !together) {
+	tbl(std::cout);
+	tbl(out, parser, taxa);
+	return 0;
+    }
+
+    if(budget && !together) {
+	try {
+	    troff(std::cout, parser, taxa, budget);
+	}
+	catch(const std::runtime_error& e) {
+	    std::cerr << "error: " << e.what() << '\n';
+	    return 1;
+	}
+	return 0;
     }
 
-    if(generate_troff) {
-	troff(std::cout, book, taxa);
+    Book book;
+    FieldView ex;
+    while(parser.get(ex)) {
+	book.add(ex);
+    }
+    if(together) {
+	cooccurrence(out, book, taxa);
     }
     else {
-	tbl(std::cout, book, taxa);
+	troff(out, book, taxa);
     }
 
     return 0;
@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2013 Jrgen Grahn
+ * Copyright (c) 2013, 2026 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -29,6 +29,11 @@
 #define GAVIA_LINEPARSE_H
 
 #include <cctype>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace Parse {
 
@@ -42,12 +47,53 @@ namespace Parse {
 	return std::isdigit(static_cast<unsigned char>(ch));
     }
 
+    /*
+     * Whitespace in blocks of 16 or 32 octets, where the instructions
+     * are available: a mask with bit n set if a[n] is whitespace.
+     * Like isspace(), in the "C" locale; we never call setlocale().
+     */
+#if defined(__AVX2__)
+    const long block = 32;
+
+    inline unsigned space_mask(const char* a)
+    {
+	const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+	const __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+	const __m256i ge = _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8('\t')), v);
+	const __m256i le = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8('\r')), v);
+	return _mm256_movemask_epi8(_mm256_or_si256(sp, _mm256_and_si256(ge, le)));
+    }
+#elif defined(__SSE2__)
+    const long block = 16;
+
+    inline unsigned space_mask(const char* a)
+    {
+	const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+	const __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+	const __m128i ge = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8('\t')), v);
+	const __m128i le = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8('\r')), v);
+	return _mm_movemask_epi8(_mm_or_si128(sp, _mm_and_si128(ge, le)));
+    }
+#else
+    const long block = 0;
+
+    inline unsigned space_mask(const char*) { return 0; }
+#endif
+
+    const unsigned all = block==32 ? ~0u : (1u << block) - 1;
+
     /**
      * Trim whitespace to the left in [a, b).
      */
     inline
     const char* ws(const char* a, const char* b)
     {
+	if(a!=b && !isspace(*a)) return a;
+	while(block && b-a >= block) {
+	    const unsigned m = ~space_mask(a) & all;
+	    if(m) return a + __builtin_ctz(m);
+	    a += block;
+	}
 	while(a!=b && isspace(*a)) a++;
 	return a;
     }
@@ -58,6 +104,11 @@ namespace Parse {
     inline
     const char* non_ws(const char* a, const char* b)
     {
+	while(block && b-a >= block) {
+	    const unsigned m = space_mask(a);
+	    if(m) return a + __builtin_ctz(m);
+	    a += block;
+	}
 	while(a!=b && !isspace(*a)) a++;
 	return a;
     }
@@ -76,10 +127,28 @@ namespace Parse {
     inline
     const char* trimr(const char* a, const char* b)
     {
+	if(a!=b && !isspace(*(b-1))) return b;
+	while(block && b-a >= block) {
+	    const unsigned m = ~space_mask(b - block) & all;
+	    if(m) return b - block + 32 - __builtin_clz(m);
+	    b -= block;
+	}
 	while(a!=b && isspace(*(b-1))) b--;
 	return b;
     }
 
+    /**
+     * Like std::find(), using the C library's memchr(), which is
+     * vectorized just like the functions above.
+     */
+    inline
+    const char* find(const char* a, const char* const b, const char ch)
+    {
+	if(a==b) return b;
+	const void* p = std::memchr(a, ch, b-a);
+	return p ? static_cast<const char*>(p) : b;
+    }
+
     /**
      * Like std::find(), but finds right brackets, while ignoring
      * earlier left-right bracket pairs.  I.e. the one after "baz" is
@@ -1,7 +1,7 @@
 /*
  * $Id: md5pp.cc,v 1.5 2011-02-06 15:05:54 grahn Exp $
  *
- * Copyright (c) 2010, 2011 Jrgen Grahn <grahn+src@snipabacken.se>
+ * Copyright (c) 2010, 2011 Jörgen Grahn <grahn+src@snipabacken.se>
  * All rights reserved.
  */
 #include "md5pp.h"
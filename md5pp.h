@@ -2,7 +2,7 @@
  *
  * $Id: md5pp.h,v 1.4 2011-02-06 15:05:54 grahn Exp $
  *
- * Copyright (c) 2010 Jrgen Grahn <grahn+src@snipabacken.se>
+ * Copyright (c) 2010 Jörgen Grahn <grahn+src@snipabacken.se>
  * All rights reserved.
  */
 #ifndef GEESE_MD5_H
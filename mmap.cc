@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "mmap.h"
+
+#include <algorithm>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+
+Mmap::Mmap(int fd)
+    : a(0),
+      b(0)
+{
+    struct stat st;
+    if(fstat(fd, &st) || !S_ISREG(st.st_mode) || !st.st_size) return;
+
+    const size_t n = st.st_size;
+    void* p = mmap(0, n, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(p==MAP_FAILED) return;
+
+    (void)madvise(p, n, MADV_SEQUENTIAL);
+    a = static_cast<const char*>(p);
+    b = a + n;
+}
+
+
+Mmap::~Mmap()
+{
+    if(a) munmap(const_cast<char*>(a), b - a);
+}
+
+
+void Mmap::swap(Mmap& other)
+{
+    std::swap(a, other.a);
+    std::swap(b, other.b);
+}
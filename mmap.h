@@ -0,0 +1,39 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_MMAP_H
+#define GROBLAD_MMAP_H
+
+#include <cstddef>
+
+
+/**
+ * A read-only mapping of an entire, open file into memory -- or
+ * nothing, if the file isn't a non-empty regular file or the mapping
+ * fails for some other reason.  The file descriptor isn't needed
+ * once the mapping is made.
+ */
+class Mmap {
+public:
+    Mmap() : a(0), b(0) {}
+    explicit Mmap(int fd);
+    ~Mmap();
+
+    void swap(Mmap& other);
+
+    bool valid() const { return a; }
+    const char* begin() const { return a; }
+    const char* end() const { return b; }
+    size_t size() const { return b - a; }
+
+private:
+    Mmap(const Mmap&);
+    Mmap& operator= (const Mmap&);
+
+    const char* a;
+    const char* b;
+};
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Jrgen Grahn
+ * Copyright (c) 2018 Jörgen Grahn
  * All rights reserved.
  *
  */
@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2018 Jrgen Grahn
+ * Copyright (c) 2018 Jörgen Grahn
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "parser.h"
+
+#include "chunk.h"
+#include "fieldview.h"
+#include "taxa.h"
+#include "workers.h"
+#include "mmap.h"
+
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace {
+
+    const size_t chunk_size = 1 << 20;
+}
+
+
+/**
+ * A chunk of input, or the start of a file (named by 'cache'),
+ * possibly all of it if it was skipped in favor of the cache.
+ */
+struct Parser::Job {
+    Job() : skipped(false), file(0), next(0) {}
+    std::unique_ptr<Cache> cache;
+    std::string name;
+    bool skipped;
+    size_t file;
+    size_t next;
+    Chunk chunk;
+    Parsed parsed;
+    bool dirty;
+    std::future<void> done;
+};
+
+
+/**
+ * Parsing just the excursions 'v' in a book, where its Index says
+ * they are.  Taxa which the others would have invented are invented
+ * here too, at the same points.
+ */
+struct Parser::Seek {
+    Seek(const std::string& name, const Index& index,
+	 const std::vector<unsigned>& v);
+    template<class Ex>
+    bool get(std::ostream& err, Taxa& spp, Ex& ex, unsigned& n);
+    void invent(Taxa& spp, unsigned n);
+
+    const std::string name;
+    const Index& index;
+    const std::vector<unsigned> v;
+    const std::vector<Index::Invented> invented;
+    size_t i;
+    size_t j;
+    Mmap map;
+};
+
+
+Parser::Seek::Seek(const std::string& name, const Index& index,
+		   const std::vector<unsigned>& v)
+    : name(name),
+      index(index),
+      v(v),
+      invented(index.invented()),
+      i(0),
+      j(0)
+{
+    const int fd = open(name.c_str(), O_RDONLY);
+    if(fd==-1) return;
+    Mmap m(fd);
+    close(fd);
+    map.swap(m);
+}
+
+
+template<class Ex>
+bool Parser::Seek::get(std::ostream& err, Taxa& spp,
+		       Ex& ex, unsigned& n)
+{
+    while(i < v.size()) {
+	n = v[i++];
+	const size_t offset = index.offset(n);
+	if(offset > map.size()) continue;
+
+	invent(spp, n);
+	const Files::Segment seg({name, index.line(n)},
+				 map.begin() + offset, map.end(),
+				 offset);
+	Files is({seg});
+	if(::get(is, err, spp, ex)) return true;
+    }
+    invent(spp, index.size());
+    return false;
+}
+
+
+/**
+ * Invent the taxa which get() would have, before excursion 'n'.
+ */
+void Parser::Seek::invent(Taxa& spp, const unsigned n)
+{
+    while(j < invented.size() && invented[j].first < n) {
+	spp.insert(invented[j++].second);
+    }
+}
+
+
+Parser::Parser(Files& is, std::ostream& err, Taxa& spp,
+	       const unsigned jobs)
+    : is(is),
+      err(err),
+      spp(spp),
+      jobs(jobs),
+      eof(false),
+      n(0),
+      filtering(false),
+      at(0),
+      at_line(1),
+      file(0),
+      org{0, 0}
+{
+    if(jobs > 1) {
+	frozen.reset(new Taxa(spp));
+	workers.reset(new Workers(jobs));
+    }
+}
+
+
+Parser::~Parser()
+{
+    /* 'workers' finishes before the jobs it's working on go away */
+    workers.reset();
+}
+
+
+/**
+ * From now on, get() only excursions with a sighting of one or more
+ * of 'taxa'.
+ */
+void Parser::only(const std::vector<TaxonId>& taxa)
+{
+    filtering = true;
+    wanted = taxa;
+    wanted_set = TaxonSet(taxa);
+}
+
+
+/**
+ * Like get(Files&, std::ostream&, Taxa&, Excursion&).
+ */
+bool Parser::get(FieldList& ex)
+{
+    for(;;) {
+	const bool ok = workers ? get_parallel(ex) : get_serial(ex);
+	if(!ok) return false;
+	if(!filtering || ex.has_one(wanted_set)) return true;
+    }
+}
+
+
+bool Parser::get(FieldView& ex)
+{
+    for(;;) {
+	if(stored(ex)) {
+	    if(!filtering || ex.has_one(wanted_set)) return true;
+	    continue;
+	}
+	if(!get(own)) return false;
+	ex.assign(own);
+	return true;
+    }
+}
+
+
+/**
+ * The Index for file number 'file', if there is one which is known
+ * to be fresh, and to match the excursions we got from it.
+ */
+const Index* Parser::index(const size_t file) const
+{
+    return file < indexes.size() ? indexes[file].get() : 0;
+}
+
+
+bool Parser::get_serial(FieldList& ex)
+{
+    for(;;) {
+	if(replay(ex)) return true;
+
+	size_t offset = 0;
+	unsigned line = 1;
+	if(is.exhausted()) {
+	    finish();
+	    const std::string* const f = is.upcoming();
+	    if(!f) return false;
+
+	    const size_t i = is.next();
+	    std::unique_ptr<Cache> c(new Cache(*f));
+	    if(use(c, i, *f)) {
+		is.skip();
+		continue;
+	    }
+	    start(*c, i, *f);
+	}
+	else {
+	    offset = is.offset();
+	    line = is.position().line + 1;
+	}
+
+	return parse(is, file, ex, offset, line);
+    }
+}
+
+
+bool Parser::get_parallel(FieldList& ex)
+{
+    for(;;) {
+	if(replay(ex)) return true;
+
+	fill();
+	if(queue.empty()) {
+	    finish();
+	    return false;
+	}
+
+	Job& job = *queue.front();
+	if(job.cache) {
+	    finish();
+	    if(job.skipped) {
+		std::unique_ptr<Cache> c;
+		c.swap(job.cache);
+		/* Fresh, but if earlier files invented taxa, it may not
+		 * fit; then it's parsed here and now instead.
+		 */
+		if(!use(c, job.file, job.name)) {
+		    again.reset(new Files(&job.name, &job.name + 1));
+		    at = 0;
+		    at_line = 1;
+		    start(*c, 0, job.name);
+		    org.file = job.file;
+		}
+		queue.pop_front();
+		continue;
+	    }
+	    start(*job.cache, job.file, job.name);
+	    job.cache.reset();
+	}
+
+	if(job.done.valid()) {
+	    job.done.get();
+	    if(job.dirty) job.parsed.parse(job.chunk, spp);
+	    if(job.next != file+1) writer.reset();
+	}
+
+	auto& items = job.parsed.items;
+	if(n < items.size()) {
+	    Parsed::Item& item = items[n++];
+	    err << item.err;
+	    if(writer) writer->add(item.err, item.ex, item.offset, item.line);
+	    ex.swap(item.ex);
+	    org.n++;
+	    return true;
+	}
+
+	err << job.parsed.err;
+	if(!job.parsed.err.empty()) writer.reset();
+	queue.pop_front();
+	n = 0;
+    }
+}
+
+
+/**
+ * Keep two chunks per thread read and queued for parsing, and note
+ * where files start.
+ */
+void Parser::fill()
+{
+    while(!eof && queue.size() < 2*jobs) {
+	std::unique_ptr<Job> job(new Job);
+	if(is.exhausted()) {
+	    const std::string* const f = is.upcoming();
+	    if(!f) {
+		eof = true;
+		break;
+	    }
+	    job->name = *f;
+	    job->file = is.next();
+	    job->cache.reset(new Cache(*f));
+	    Cache& c = *job->cache;
+	    if((c.fresh() || c.appended()) && Index(c).valid()) {
+		is.skip();
+		job->skipped = true;
+		queue.push_back(std::move(job));
+		continue;
+	    }
+	}
+
+	if(!job->chunk.get(is, chunk_size)) {
+	    eof = true;
+	    break;
+	}
+	job->next = is.next();
+
+	Job* const p = job.get();
+	const Taxa* const spp = frozen.get();
+	p->done = workers->submit([p, spp] {
+				      try {
+					  p->parsed.parse(p->chunk, *spp);
+					  p->dirty = false;
+				      }
+				      catch(const Unfamiliar&) {
+					  p->dirty = true;
+				      }
+				  });
+	queue.push_back(std::move(job));
+    }
+}
+
+
+/**
+ * Helper. At the start of file number 'i', named 'name', arrange to
+ * get its excursions from its cache 'c' (or, after only(), using its
+ * index) rather than parsing it.  This is possible if both are fresh
+ * and fit the taxa as they are now.
+ *
+ * Or if the book has only grown since; then we get the rest by
+ * parsing just that, and write a new cache.
+ */
+bool Parser::use(std::unique_ptr<Cache>& c, const size_t i,
+		 const std::string& name)
+{
+    if(!c->fits(spp)) return false;
+    const bool fresh = c->fresh();
+    if(!fresh && !c->appended()) return false;
+    std::unique_ptr<Index> ix(new Index(*c));
+    if(!ix->valid()) return false;
+
+    if(!fresh) {
+	const int fd = open(name.c_str(), O_RDONLY);
+	if(fd==-1) return false;
+	Mmap m(fd);
+	close(fd);
+	if(m.size() <= c->length()) return false;
+	tail.swap(m);
+
+	at = c->length();
+	at_line = c->lines() + 1;
+	const Files::Segment seg({name, at_line},
+				 tail.begin() + at, tail.end(), at);
+	again.reset(new Files({seg}));
+	start(*c, i, name);
+	writer->keep(*c, *ix);
+    }
+
+    org = {i, 0};
+    if(filtering) {
+	seek.reset(new Seek(name, *ix, ix->find(wanted)));
+    }
+    else {
+	cache.swap(c);
+    }
+
+    if(indexes.size() <= i) indexes.resize(i+1);
+    indexes[i].swap(ix);
+    return true;
+}
+
+
+/**
+ * Helper. The next excursion from a cache or an index.
+ */
+template<class Ex>
+bool Parser::stored(Ex& ex)
+{
+    if(cache) {
+	if(cache->get(err, spp, ex)) {
+	    org.n++;
+	    return true;
+	}
+	cache.reset();
+    }
+
+    if(seek) {
+	unsigned n;
+	if(seek->get(err, spp, ex, n)) {
+	    org.n = n + 1;
+	    return true;
+	}
+	org.n = seek->index.size();
+	seek.reset();
+    }
+
+    return false;
+}
+
+
+/**
+ * Helper. The next excursion from a cache, from an index, or from a
+ * file we had to go back and parse after all.
+ */
+bool Parser::replay(FieldList& ex)
+{
+    if(stored(ex)) return true;
+
+    if(again) {
+	bool ok = true;
+	size_t offset = at;
+	unsigned line = at_line;
+	if(again->next()) {
+	    ok = !again->exhausted();
+	    offset = again->offset();
+	    line = again->position().line + 1;
+	}
+	if(ok && parse(*again, 0, ex, offset, line)) return true;
+	finish();
+	again.reset();
+	Mmap none;
+	tail.swap(none);
+    }
+
+    return false;
+}
+
+
+/**
+ * Helper. Like get(), but also feeding the cache being written for
+ * file number 'i' in 'src' -- unless get() goes beyond that file,
+ * or finds nothing.  'offset' and 'line' is where it starts reading.
+ */
+bool Parser::parse(Files& src, const size_t i, FieldList& ex,
+		   const size_t offset, const unsigned line)
+{
+    bool ok;
+    if(!writer) {
+	ok = ::get(src, err, spp, ex);
+    }
+    else {
+	buf.str("");
+	ok = ::get(src, buf, spp, ex);
+	const std::string s = buf.str();
+	err << s;
+	if(ok && src.next()==i+1) {
+	    writer->add(s, ex, offset, line);
+	}
+	else {
+	    writer.reset();
+	}
+    }
+
+    if(ok) org.n++;
+    return ok;
+}
+
+
+/**
+ * Helper. Start writing a cache for 'c', which is file number 'i',
+ * and start counting excursions in it.
+ */
+void Parser::start(Cache& c, const size_t i, const std::string& name)
+{
+    writer.reset(new Cache::Writer(c, spp));
+    building = name;
+    file = i;
+    org = {i, 0};
+}
+
+
+/**
+ * Helper. The file we've been writing a cache for has ended; if it
+ * ended cleanly, the cache and index are in place.
+ */
+void Parser::finish()
+{
+    if(building.empty()) return;
+
+    std::unique_ptr<Index> ix;
+    if(writer && writer->commit()) {
+	Cache c(building);
+	ix.reset(new Index(c));
+	if(!ix->valid()) ix.reset();
+    }
+    if(indexes.size() <= org.file) indexes.resize(org.file+1);
+    indexes[org.file].swap(ix);
+
+    writer.reset();
+    building.clear();
+}
@@ -0,0 +1,124 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_PARSER_H
+#define GROBLAD_PARSER_H
+
+#include "cache.h"
+#include "taxon.h"
+#include "excursion.h"
+#include "taxonset.h"
+
+#include <sstream>
+#include <deque>
+#include <vector>
+#include <memory>
+
+class Files;
+class Taxa;
+class FieldView;
+class Workers;
+
+/**
+ * Reading excursions like get(Files&, ...) does, but optionally
+ * with the parsing spread over 'jobs' threads.  The excursions still
+ * come out in order, and so do the diagnostics, with the same
+ * positions in them.
+ *
+ * The input is cut into Chunks between excursions, which are parsed
+ * against a private copy of 'spp'. The odd chunk which needs to
+ * augment it (with unfamiliar taxa) is parsed again, in order,
+ * against 'spp' itself.
+ *
+ * A file with a fresh Cache which fits 'spp' isn't parsed at all.
+ * If lines have been appended to it since the cache was made, only
+ * those are parsed.  Other files which get() parses cleanly, from
+ * start to end, get a new cache along the way.
+ *
+ * After only(), just the excursions with a sighting of some of the
+ * given taxa come out. Files with an Index are then not even read
+ * in full; only the excursions the index points out are parsed,
+ * and only their diagnostics are seen.
+ *
+ * get() can also give a FieldView, which is valid until the next
+ * get().  From a cache or an index, it refers directly to the text
+ * there; otherwise it's a view of a FieldList parsed as usual.
+ */
+class Parser {
+public:
+    Parser(Files& is, std::ostream& err, Taxa& spp,
+	   unsigned jobs = 1);
+    ~Parser();
+
+    void only(const std::vector<TaxonId>& taxa);
+    bool get(FieldList& ex);
+    bool get(FieldView& ex);
+
+    /**
+     * Where the last excursion came from: the n:th one
+     * (counting from 1) in file number 'file'.
+     */
+    struct Origin {
+	size_t file;
+	unsigned n;
+    };
+    const Origin& origin() const { return org; }
+    const Index* index(size_t file) const;
+
+    /* with jobs > 1: the threads, for others to share, and 'spp'
+     * as it was before get() added to it
+     */
+    Workers* pool() const { return workers.get(); }
+    const Taxa* initial() const { return frozen.get(); }
+
+private:
+    Parser(const Parser&);
+    Parser& operator= (const Parser&);
+
+    struct Job;
+    struct Seek;
+    bool get_serial(FieldList& ex);
+    bool get_parallel(FieldList& ex);
+    void fill();
+
+    bool use(std::unique_ptr<Cache>& c, size_t i, const std::string& name);
+    template<class Ex> bool stored(Ex& ex);
+    bool replay(FieldList& ex);
+    bool parse(Files& src, size_t i, FieldList& ex,
+	       size_t offset, unsigned line);
+    void start(Cache& c, size_t i, const std::string& name);
+    void finish();
+
+    Files& is;
+    std::ostream& err;
+    Taxa& spp;
+    const unsigned jobs;
+    bool eof;
+    size_t n;
+    std::deque<std::unique_ptr<Job>> queue;
+    std::unique_ptr<const Taxa> frozen;
+    std::unique_ptr<Workers> workers;
+
+    bool filtering;
+    std::vector<TaxonId> wanted;
+    TaxonSet wanted_set;
+
+    std::unique_ptr<Cache> cache;
+    std::unique_ptr<Seek> seek;
+    std::unique_ptr<Files> again;
+    Mmap tail;
+    size_t at;
+    unsigned at_line;
+    std::string building;
+    std::unique_ptr<Cache::Writer> writer;
+    size_t file;
+    std::ostringstream buf;
+
+    Origin org;
+    std::vector<std::unique_ptr<Index>> indexes;
+    FieldList own;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "pipeline.h"
+
+#include "files...h"
+
+#include <sstream>
+#include <iostream>
+
+
+namespace {
+
+    const size_t chunk_size = 1 << 20;
+    const size_t depth = 4;
+}
+
+
+/**
+ * A Chunk, and whatever Files had to say while reading it.
+ */
+struct Pipeline::Read {
+    Chunk chunk;
+    std::string err;
+};
+
+
+Pipeline::Pipeline(Files& is, Taxa& spp)
+    : is(is),
+      spp(spp),
+      eof(false),
+      chunks(depth),
+      parsed(depth),
+      reader(&Pipeline::read, this),
+      parser(&Pipeline::parse, this)
+{}
+
+
+Pipeline::~Pipeline()
+{
+    while(get()) {}
+    reader.join();
+    parser.join();
+}
+
+
+/**
+ * The next chunk, or null at end of input.
+ */
+std::unique_ptr<Parsed> Pipeline::get()
+{
+    if(eof) return nullptr;
+    std::unique_ptr<Parsed> p = parsed.pop();
+    eof = !p;
+    return p;
+}
+
+
+void Pipeline::read()
+{
+    std::ostringstream err;
+    is.errors(err);
+
+    std::unique_ptr<Read> p(new Read);
+    while(p->chunk.get(is, chunk_size)) {
+	p->err = err.str();
+	err.str("");
+	chunks.push(std::move(p));
+	p.reset(new Read);
+    }
+
+    /* the last errors, with an empty chunk */
+    is.errors(std::cerr);
+    p->err = err.str();
+    chunks.push(std::move(p));
+    chunks.push(nullptr);
+}
+
+
+void Pipeline::parse()
+{
+    while(std::unique_ptr<Read> p = chunks.pop()) {
+	std::unique_ptr<Parsed> q(new Parsed);
+	if(!p->chunk.empty()) q->parse(p->chunk, spp);
+	if(q->items.empty()) {
+	    q->err.insert(0, p->err);
+	}
+	else {
+	    q->items.front().err.insert(0, p->err);
+	}
+	parsed.push(std::move(q));
+    }
+    parsed.push(nullptr);
+}
@@ -0,0 +1,50 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_PIPELINE_H
+#define GROBLAD_PIPELINE_H
+
+#include "chunk.h"
+#include "spsc.h"
+
+#include <memory>
+#include <thread>
+
+class Files;
+class Taxa;
+
+/**
+ * Reading and parsing, as two stages on threads of their own,
+ * connected by Spsc queues.  The caller is the third stage, and gets
+ * the Parsed chunks in order, with all diagnostics (including the
+ * ones from Files) inside them.
+ *
+ * Nothing else may use 'is' or 'spp' until get() has returned null.
+ */
+class Pipeline {
+public:
+    Pipeline(Files& is, Taxa& spp);
+    ~Pipeline();
+
+    std::unique_ptr<Parsed> get();
+
+private:
+    Pipeline(const Pipeline&);
+    Pipeline& operator= (const Pipeline&);
+
+    struct Read;
+    void read();
+    void parse();
+
+    Files& is;
+    Taxa& spp;
+    bool eof;
+    Spsc<std::unique_ptr<Read>> chunks;
+    Spsc<std::unique_ptr<Parsed>> parsed;
+    std::thread reader;
+    std::thread parser;
+};
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013 Jrgen Grahn
+ * Copyright (c) 2013 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -25,11 +25,147 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "regex.h"
+#include "fixed.h"
 
+#include <memory>
+#include <cstring>
 #include <sys/types.h>
 #include <regex.h>
 
 
+namespace {
+
+    bool special(const char c)
+    {
+	return c && std::strchr(".[]()*+?{}|^$\\", c);
+    }
+
+    /**
+     * Helper for required(). Skip a bracket expression [p, ...],
+     * returning what comes after it.
+     */
+    const char* bracket(const char* p)
+    {
+	p++;
+	if(*p=='^') p++;
+	if(*p==']') p++;
+	while(*p && *p!=']') {
+	    if(*p=='[' && (p[1]==':' || p[1]=='.' || p[1]=='=')) {
+		const char k[3] = { p[1], ']', 0 };
+		const char* q = std::strstr(p+2, k);
+		if(!q) return p + std::strlen(p);
+		p = q + 2;
+		continue;
+	    }
+	    p++;
+	}
+	return *p ? p+1 : p;
+    }
+
+    /**
+     * Helper for required(). Skip a parenthesized group (p, ...),
+     * returning what comes after it.
+     */
+    const char* group(const char* p)
+    {
+	unsigned depth = 0;
+	while(*p) {
+	    switch(*p) {
+	    case '[': p = bracket(p); continue;
+	    case '\\': if(p[1]) p++; break;
+	    case '(': depth++; break;
+	    case ')': if(!--depth) return p+1; break;
+	    }
+	    p++;
+	}
+	return p;
+    }
+
+    /**
+     * Helper for required(). Skip the quantifier at 'p', if there
+     * is one.
+     */
+    const char* quantifier(const char* p)
+    {
+	if(*p=='*' || *p=='+' || *p=='?') return p+1;
+	if(*p=='{') {
+	    const char* q = std::strchr(p, '}');
+	    return q ? q+1 : p + std::strlen(p);
+	}
+	return p;
+    }
+
+    /**
+     * The longest string which any match of the extended regular
+     * expression 're' must contain, or "" if there's no such thing
+     * -- or if 're' is too complicated to tell.  Parenthesized groups,
+     * bracket expressions and anything quantified but by + are
+     * simply not part of it; an alternation anywhere means giving up.
+     */
+    std::string required(const std::string& re)
+    {
+	std::string best;
+	std::string acc;
+	auto flush = [&best, &acc] {
+			 if(acc.size() > best.size()) best = acc;
+			 acc.clear();
+		     };
+
+	const char* p = re.c_str();
+	if(std::strchr(p, '|')) return "";
+	while(*p) {
+	    char c = *p;
+	    if(c=='\\' && special(p[1])) {
+		c = p[1];
+		p += 2;
+	    }
+	    else if(c=='[') {
+		flush();
+		p = quantifier(bracket(p));
+		continue;
+	    }
+	    else if(c=='(') {
+		flush();
+		p = quantifier(group(p));
+		continue;
+	    }
+	    else if(c=='\\' || c=='{') {
+		/* \1, \w and so on, or a stray interval */
+		flush();
+		p = quantifier(c=='{' ? p : p + 1 + !!p[1]);
+		continue;
+	    }
+	    else if(special(c)) {
+		flush();
+		p = quantifier(p+1);
+		continue;
+	    }
+	    else {
+		p++;
+	    }
+
+	    /* c is an ordinary character, possibly quantified -- and
+	     * the quantifier itself too, like in a+? or a+{0}
+	     */
+	    const char* const q = quantifier(p);
+	    if(*p=='+' && !(*q && std::strchr("*+?{", *q))) {
+		acc.push_back(c);
+		flush();
+	    }
+	    else if(*p=='+' || *p=='*' || *p=='?' || *p=='{') {
+		flush();
+	    }
+	    else {
+		acc.push_back(c);
+	    }
+	    p = q;
+	}
+	flush();
+	return best;
+    }
+}
+
+
 /**
  * Needed only because POSIX regexes don't allow for forward
  * declarations -- there is no struct regex, only a regex_t typedef.
@@ -40,12 +176,16 @@ struct Regex::Wrapper {
 		      REG_EXTENDED|
 		      REG_ICASE|
 		      REG_NOSUB);
+	if(!err) required = ::required(regex);
+	if(!required.empty()) literal.reset(new Fixed(required, true));
     }
     ~Wrapper() {
 	if(!err) regfree(&re);
     }
     int err;
     regex_t re;
+    std::string required;
+    std::unique_ptr<Fixed> literal;
 };
 
 
@@ -80,7 +220,42 @@ std::string Regex::error() const
 }
 
 
+/**
+ * A string which every match contains (ignoring ASCII case), or ""
+ * if there's no such thing, or it's unknown.
+ */
+const std::string& Regex::literal() const
+{
+    return wrapper->required;
+}
+
+
+/**
+ * Strings which don't contain what a match needs to contain aren't
+ * passed to regexec(3) at all.
+ */
 bool Regex::match(const char* s) const
 {
+    if(wrapper->literal && !wrapper->literal->match(s)) return false;
     return !regexec(&wrapper->re, s, 0, 0, 0);
 }
+
+
+/**
+ * Like match(const char*), but for the text [a, b), which doesn't
+ * need to be NUL-terminated.  Without REG_STARTEND in the C library,
+ * it's copied to a std::string first.
+ */
+bool Regex::match(const char* a, const char* b) const
+{
+    if(wrapper->literal && !wrapper->literal->match(a, b)) return false;
+#ifdef REG_STARTEND
+    regmatch_t m;
+    m.rm_so = 0;
+    m.rm_eo = b - a;
+    return !regexec(&wrapper->re, a, 1, &m, REG_STARTEND);
+#else
+    const std::string s(a, b);
+    return !regexec(&wrapper->re, s.c_str(), 0, 0, 0);
+#endif
+}
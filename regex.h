@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (C) 2001, 2013 Jrgen Grahn
+ * Copyright (C) 2001, 2013 Jörgen Grahn
  * All rights reserved.
  */
 #ifndef GAVIA_REGEX_H
@@ -22,9 +22,11 @@ public:
 
     bool bad() const;
     std::string error() const;
+    const std::string& literal() const;
 
     bool match(const std::string& s) const { return match(s.c_str()); }
     bool match(const char* s) const;
+    bool match(const char* a, const char* b) const;
 
     struct Wrapper;
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "replace.h"
+
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+namespace {
+
+    /**
+     * The permissions for a file made from 'origin'.  There's no way
+     * to read the umask without setting it, so it's briefly 0 -- but
+     * not while anything else is created.
+     */
+    mode_t mode_of(const std::string& origin)
+    {
+	struct stat st;
+	if(stat(origin.c_str(), &st)) return 0600;
+	const mode_t mask = umask(0);
+	umask(mask);
+	return st.st_mode & 0666 & ~mask;
+    }
+}
+
+
+Replacement::Replacement(const std::string& path, const std::string& origin)
+    : path(path),
+      fd(-1)
+{
+    std::vector<char> name(path.begin(), path.end());
+    const char suffix[] = ".XXXXXX";
+    name.insert(name.end(), suffix, suffix + sizeof suffix);
+    fd = mkstemp(&name[0]);
+    if(fd==-1) return;
+    tmp = &name[0];
+    if(fchmod(fd, mode_of(origin))) fail();
+}
+
+
+Replacement::~Replacement()
+{
+    if(fd!=-1) fail();
+}
+
+
+void Replacement::write(const char* p, const char* const e)
+{
+    while(fd!=-1 && p!=e) {
+	const ssize_t rc = ::write(fd, p, e - p);
+	if(rc==-1 && errno==EINTR) continue;
+	if(rc<=0) fail();
+	else p += rc;
+    }
+}
+
+
+/**
+ * Put the file in place, returning true if that worked.
+ */
+bool Replacement::commit()
+{
+    if(fd==-1) return false;
+    const bool ok = !close(fd) && !rename(tmp.c_str(), path.c_str());
+    if(!ok) unlink(tmp.c_str());
+    fd = -1;
+    return ok;
+}
+
+
+void Replacement::fail()
+{
+    close(fd);
+    unlink(tmp.c_str());
+    fd = -1;
+}
@@ -0,0 +1,47 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_REPLACE_H
+#define GROBLAD_REPLACE_H
+
+#include <string>
+
+
+/**
+ * A new version of the file 'path', written to a temporary file next
+ * to it and renamed into place by commit() -- so that a reader sees
+ * either the old file or all of the new one.  Unless it's committed,
+ * it's removed again.
+ *
+ * It's made from the file 'origin', and anyone who may read that may
+ * read this one: it gets the read and write permissions of 'origin',
+ * minus the umask.  If there's no such file, only the owner may read
+ * it.
+ *
+ * Once something has failed, it's no longer valid() and the rest is
+ * ignored.
+ */
+class Replacement {
+public:
+    Replacement(const std::string& path, const std::string& origin);
+    ~Replacement();
+
+    bool valid() const { return fd!=-1; }
+    void write(const char* p, const char* e);
+    void write(const std::string& s) { write(s.data(), s.data() + s.size()); }
+    bool commit();
+
+private:
+    Replacement(const Replacement&);
+    Replacement& operator= (const Replacement&);
+
+    void fail();
+
+    const std::string path;
+    std::string tmp;
+    int fd;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "spill.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <iterator>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+
+
+namespace {
+
+    [[noreturn]] void fail(const char* what)
+    {
+	throw std::runtime_error(std::string(what) + ": "
+				 + std::strerror(errno));
+    }
+
+    /* A pair in a run is its key and value, without the padding
+     * between them in a Pair.
+     */
+    const size_t packed = sizeof(uint32_t) + sizeof(uint64_t);
+
+    /* At most this many runs are merged at once.
+     */
+    const size_t fan_in = 64;
+
+    /**
+     * Write [a, b) to 'f' in the packed form.
+     */
+    void write(FILE* f, const Spill::Pair* a, const Spill::Pair* const b)
+    {
+	char buf[packed * 1024];
+	while(a!=b) {
+	    char* p = buf;
+	    for(; a!=b && p!=std::end(buf); a++) {
+		std::memcpy(p, &a->key, sizeof a->key);
+		p += sizeof a->key;
+		std::memcpy(p, &a->val, sizeof a->val);
+		p += sizeof a->val;
+	    }
+	    const size_t n = p - buf;
+	    if(std::fwrite(buf, 1, n, f) != n) fail("writing temporary file");
+	}
+    }
+
+    /**
+     * Rewind 'f' for reading what has been written to it.
+     */
+    void restart(FILE* f)
+    {
+	if(std::fflush(f) || std::fseek(f, 0, SEEK_SET)) {
+	    fail("rewinding temporary file");
+	}
+    }
+}
+
+
+/**
+ * A new, unnamed temporary file in $TMPDIR (or /tmp), open for
+ * writing and reading.  Or an exception.
+ */
+FILE* Spill::temporary()
+{
+    const char* dir = std::getenv("TMPDIR");
+    if(!dir || !*dir) dir = "/tmp";
+    std::string s = dir;
+    s += "/groblad.XXXXXX";
+    std::vector<char> path(s.begin(), s.end());
+    path.push_back('\0');
+
+    const int fd = mkstemp(&path[0]);
+    if(fd==-1) fail(&path[0]);
+    unlink(&path[0]);
+    FILE* const f = fdopen(fd, "w+");
+    if(!f) {
+	close(fd);
+	fail("fdopen");
+    }
+    return f;
+}
+
+
+/**
+ * The unmerged rest of a sorted run: a buffer of it, and maybe the
+ * file with the rest.
+ */
+struct Spill::Run {
+    Run(FILE* f, size_t size) : f(f), buf(size), i(0), n(0) {}
+    FILE* f;
+    std::vector<Pair> buf;
+    std::vector<char> raw;
+    size_t i;
+    size_t n;
+
+    const Pair& front() const { return buf[i]; }
+    bool next() { return ++i < n || fill(); }
+    bool fill();
+};
+
+
+/**
+ * Read the next bufferful, and return false at the end.
+ */
+bool Spill::Run::fill()
+{
+    if(!f) return false;
+    raw.resize(buf.size() * packed);
+    n = std::fread(&raw[0], packed, buf.size(), f);
+    if(std::ferror(f)) fail("reading temporary file");
+    const char* p = raw.data();
+    for(size_t j=0; j<n; j++) {
+	std::memcpy(&buf[j].key, p, sizeof buf[j].key);
+	p += sizeof buf[j].key;
+	std::memcpy(&buf[j].val, p, sizeof buf[j].val);
+	p += sizeof buf[j].val;
+    }
+    i = 0;
+    return n;
+}
+
+
+namespace {
+
+    /**
+     * Ordering runs for a min-heap.
+     */
+    template <class P>
+    bool after(const P& a, const P& b)
+    {
+	return b->front() < a->front();
+    }
+}
+
+
+Spill::Spill(const size_t budget)
+    : max(std::max(budget / sizeof(Pair), size_t(1024))),
+      merging(false)
+{}
+
+
+Spill::~Spill()
+{
+    for(FILE* f : files) std::fclose(f);
+}
+
+
+void Spill::add(const unsigned key, const uint64_t val)
+{
+    if(v.size()==max) spill();
+    v.push_back({key, val});
+}
+
+
+/**
+ * Get the next pair in order, or return false when there are no
+ * more.  Once get() has been called, add() must not be.
+ */
+bool Spill::get(unsigned& key, uint64_t& val)
+{
+    if(!merging) merge();
+    Pair p;
+    if(!pop(heap, p)) return false;
+    key = p.key;
+    val = p.val;
+    return true;
+}
+
+
+/**
+ * Helper. Take the smallest pair from the runs in 'heap'.
+ */
+bool Spill::pop(Heap& heap, Pair& p)
+{
+    if(heap.empty()) return false;
+
+    std::pop_heap(heap.begin(), heap.end(), after<std::unique_ptr<Run>>);
+    Run& run = *heap.back();
+    p = run.front();
+    if(run.next()) {
+	std::push_heap(heap.begin(), heap.end(), after<std::unique_ptr<Run>>);
+    }
+    else {
+	heap.pop_back();
+    }
+    return true;
+}
+
+
+/**
+ * Helper. Write what's in memory as a run.
+ */
+void Spill::spill()
+{
+    std::sort(v.begin(), v.end());
+    FILE* const f = temporary();
+    files.push_back(f);
+    write(f, v.data(), v.data() + v.size());
+    v.clear();
+}
+
+
+/**
+ * Helper. Set up the merge of the runs, and of what's still in
+ * memory -- which doesn't need to be written anywhere.  The
+ * memory budget is shared between the runs' buffers.
+ */
+void Spill::merge()
+{
+    merging = true;
+    std::sort(v.begin(), v.end());
+
+    while(files.size() > fan_in) combine(fan_in);
+
+    const size_t size = std::max(max / (files.size() + 1), size_t(256));
+    heap = open(files.size(), size);
+
+    if(!v.empty()) {
+	std::unique_ptr<Run> run(new Run(0, 0));
+	run->buf.swap(v);
+	run->n = run->buf.size();
+	heap.push_back(std::move(run));
+    }
+    std::make_heap(heap.begin(), heap.end(), after<std::unique_ptr<Run>>);
+}
+
+
+/**
+ * Helper. Merge the first 'n' runs into a new one, last in line.
+ */
+void Spill::combine(const size_t n)
+{
+    FILE* const f = temporary();
+    files.push_back(f);
+
+    const size_t size = std::max(max / (n + 1), size_t(256));
+    Heap h = open(n, size);
+    std::make_heap(h.begin(), h.end(), after<std::unique_ptr<Run>>);
+    std::vector<Pair> acc;
+    acc.reserve(size);
+    Pair p;
+    while(pop(h, p)) {
+	acc.push_back(p);
+	if(acc.size()==size) {
+	    write(f, acc.data(), acc.data() + acc.size());
+	    acc.clear();
+	}
+    }
+    write(f, acc.data(), acc.data() + acc.size());
+
+    for(size_t i=0; i<n; i++) std::fclose(files[i]);
+    files.erase(files.begin(), files.begin() + n);
+}
+
+
+/**
+ * Helper. Start reading the first 'n' runs, with 'size' pairs
+ * buffered from each.  Empty runs are left out.
+ */
+Spill::Heap Spill::open(const size_t n, const size_t size)
+{
+    Heap h;
+    for(size_t i=0; i<n; i++) {
+	restart(files[i]);
+	std::unique_ptr<Run> run(new Run(files[i], size));
+	if(run->fill()) h.push_back(std::move(run));
+    }
+    return h;
+}
@@ -0,0 +1,65 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_SPILL_H
+#define GROBLAD_SPILL_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstdio>
+
+
+/**
+ * Sorting more (key, value) pairs than fit in memory.  Whenever
+ * 'budget' octets' worth have been add()ed, they're sorted and
+ * written to a temporary file -- a run.  Then get() merges the runs,
+ * reading a little at a time from each.
+ *
+ * The temporary files go in $TMPDIR or /tmp, and are gone already
+ * when they're created.  Failing to write or read them throws
+ * std::runtime_error.  If there are too many runs to have them all
+ * open at once, some are first merged into longer ones.
+ */
+class Spill {
+public:
+    explicit Spill(size_t budget);
+    ~Spill();
+
+    void add(unsigned key, uint64_t val);
+    bool get(unsigned& key, uint64_t& val);
+    size_t runs() const { return files.size(); }
+
+    static FILE* temporary();
+
+    struct Pair {
+	uint32_t key;
+	uint64_t val;
+	bool operator< (const Pair& other) const {
+	    if(key != other.key) return key < other.key;
+	    return val < other.val;
+	}
+    };
+
+private:
+    Spill(const Spill&);
+    Spill& operator= (const Spill&);
+
+    struct Run;
+    typedef std::vector<std::unique_ptr<Run>> Heap;
+    void spill();
+    void merge();
+    void combine(size_t n);
+    Heap open(size_t n, size_t size);
+    static bool pop(Heap& heap, Pair& p);
+
+    const size_t max;
+    std::vector<Pair> v;
+    std::vector<FILE*> files;
+    bool merging;
+    Heap heap;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_SPSC_H
+#define GROBLAD_SPSC_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+
+/**
+ * A bounded queue between one producer thread and one consumer
+ * thread, without locks while it's neither full nor empty.  Pushing
+ * to a full queue, or popping from an empty one, spins for a while
+ * and then sleeps until the other side has caught up.
+ */
+template<class T>
+class Spsc {
+public:
+    explicit Spsc(size_t n)
+	: v(n+1),
+	  head(0),
+	  tail(0),
+	  sleepers(0)
+    {}
+
+    void push(T val);
+    T pop();
+
+private:
+    Spsc(const Spsc&);
+    Spsc& operator= (const Spsc&);
+
+    template<class Pred> void wait(Pred ready);
+    void wake();
+
+    std::vector<T> v;
+    /* the next to pop, and the next to push */
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+
+    /* threads in wait(); both sides may be there for a moment */
+    std::atomic<unsigned> sleepers;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+
+/**
+ * Wait until ready(): spin briefly, since the other side is usually
+ * just about to catch up, then sleep on the condition variable.
+ */
+template<class T>
+template<class Pred>
+void Spsc<T>::wait(Pred ready)
+{
+    for(unsigned i=0; i<1000; i++) {
+	if(ready()) return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    sleepers++;
+    while(!ready()) cv.wait(lock);
+    sleepers--;
+}
+
+
+/**
+ * Wake the other side, if wait() put it to sleep.  Called after
+ * moving head or tail; both are sequentially consistent, so either
+ * this sees the sleeper, or the sleeper sees the move.
+ */
+template<class T>
+void Spsc<T>::wake()
+{
+    if(sleepers.load()) {
+	std::lock_guard<std::mutex> lock(mutex);
+	cv.notify_all();
+    }
+}
+
+
+template<class T>
+void Spsc<T>::push(T val)
+{
+    const size_t t = tail.load(std::memory_order_relaxed);
+    const size_t next = (t+1) % v.size();
+    if(next==head.load()) {
+	wait([this, next] { return next!=head.load(); });
+    }
+    v[t] = std::move(val);
+    tail.store(next);
+    wake();
+}
+
+
+template<class T>
+T Spsc<T>::pop()
+{
+    const size_t h = head.load(std::memory_order_relaxed);
+    if(h==tail.load()) {
+	wait([this, h] { return h!=tail.load(); });
+    }
+    T val = std::move(v[h]);
+    head.store((h+1) % v.size());
+    wake();
+    return val;
+}
+
+#endif
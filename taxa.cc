@@ -1,14 +1,17 @@
 /*
- * Copyright (c) 2013, 2014, 2020 Jrgen Grahn
+ * Copyright (c) 2013, 2014, 2020 Jörgen Grahn
  * All rights reserved.
  *
  */
 #include "taxa.h"
 #include "lineparse.h"
+#include "fnv.h"
 
 #include <unordered_set>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <cstdint>
 #include <cassert>
 
 
@@ -54,6 +57,15 @@ namespace {
  *
  */
 Taxa::Taxa(std::istream& is, std::ostream& err)
+{
+    parse(is, err);
+}
+
+
+/**
+ * Helper for the constructors.
+ */
+void Taxa::parse(std::istream& is, std::ostream& err)
 {
     Genera genera;
     std::string s;
@@ -137,24 +149,23 @@ TaxonId Taxa::insert(const std::string& name)
     if(!find(name)) {
 	id = TaxonId(v.size() + 1);
 	v.emplace_back(id, false, name);
-	m[name] = id;
+	m.insert(name, id, fnv1a(name.data(), name.size()));
     }
     return id;
 }
 
 
 /**
- * Find a taxon by name (or scientific name, or alias)
- * and return its id.  Returns the nil id if not found.
+ * Like find(const std::string&), for the name [name, name+len).
  */
-TaxonId Taxa::find(const std::string& name) const
+TaxonId Taxa::find(const char* name, const size_t len) const
 {
-    TaxonId id;
-    auto i = m.find(name);
-    if(i!=m.end()) {
-	id = i->second;
+    const unsigned h = fnv1a(name, len);
+    if(snapshot) {
+	const TaxonId id = indexed(name, len, h);
+	if(id) return id;
     }
-    return id;
+    return m.find(name, len, h);
 }
 
 
@@ -164,7 +175,8 @@ TaxonId Taxa::find(const std::string& name) const
 std::vector<std::string> Taxa::names() const
 {
     std::vector<std::string> acc;
-    for(const auto& item: m) acc.push_back(item.first);
+    if(snapshot) indexed_names(acc);
+    for(const auto& item: m) acc.push_back(item.name);
     return acc;
 }
 
@@ -195,6 +207,16 @@ std::vector<TaxonId> Taxa::match(const Regex& re) const
 }
 
 
+std::vector<TaxonId> Taxa::match(const Fixed& re) const
+{
+    std::vector<TaxonId> acc;
+    for(const Taxon& sp: v) {
+	if(sp.match(re)) acc.push_back(sp.id);
+    }
+    return acc;
+}
+
+
 /**
  * Dump the taxon list, for debugging purposes.
  */
@@ -241,8 +263,55 @@ void Taxa::map(const Taxon& sp, std::ostream& err)
  */
 void Taxa::map(const std::string& name, TaxonId id, std::ostream& err)
 {
-    auto p = m.insert(std::make_pair(name, id));
-    if(!p.second && p.first->second != id) {
+    const unsigned h = fnv1a(name.data(), name.size());
+    const TaxonId other = m.find(name.data(), name.size(), h);
+    if(!other) {
+	m.insert(name, id, h);
+    }
+    else if(other != id) {
 	err << "warning: \"" << name << "\" has already been used to name a different taxon\n";
     }
 }
+
+
+TaxonId Taxa::Table::find(const char* s, const size_t len,
+			  const unsigned h) const
+{
+    if(slots.empty()) return TaxonId();
+    const size_t mask = slots.size() - 1;
+    for(size_t i = h & mask; slots[i].n; i = (i + 1) & mask) {
+	if(slots[i].h != h) continue;
+	const Entry& e = v[slots[i].n - 1];
+	if(e.name.size()==len && std::memcmp(e.name.data(), s, len)==0) {
+	    return e.id;
+	}
+    }
+    return TaxonId();
+}
+
+
+/**
+ * Add 's', which isn't in the table, and its hash 'h'.
+ */
+void Taxa::Table::insert(const std::string& s, const TaxonId id,
+			 const unsigned h)
+{
+    v.push_back({s, id});
+
+    if(2 * v.size() > slots.size()) {
+	std::vector<Slot> old(std::max(size_t(64), 2 * slots.size()));
+	old.swap(slots);
+	const size_t mask = slots.size() - 1;
+	for(const Slot& slot : old) {
+	    if(!slot.n) continue;
+	    size_t i = slot.h & mask;
+	    while(slots[i].n) i = (i + 1) & mask;
+	    slots[i] = slot;
+	}
+    }
+
+    const size_t mask = slots.size() - 1;
+    size_t i = h & mask;
+    while(slots[i].n) i = (i + 1) & mask;
+    slots[i] = {h, unsigned(v.size())};
+}
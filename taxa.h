@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2013, 2014 Jrgen Grahn
+ * Copyright (c) 2013, 2014 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -30,12 +30,14 @@
 
 #include "taxon.h"
 
+#include <string>
 #include <vector>
-#include <unordered_map>
+#include <memory>
 #include <iosfwd>
 
 
 class Regex;
+class Fixed;
 
 /**
  * A "species list": a list of taxa in roughly taxonomical order with
@@ -48,19 +50,23 @@ class Regex;
  * Genera are also available, as e.g. "Primula sp".
  *
  * Such a list is typically initialized from a text file, but there
- * are provisions for adding to it.
+ * are provisions for adding to it.  The text file may have a
+ * snapshot, which is quicker to read.
  */
 class Taxa {
 public:
     Taxa(std::istream& is, std::ostream& err);
+    Taxa(const std::string& file, std::istream& is, std::ostream& err);
 
     TaxonId insert(const std::string& name);
 
     TaxonId find(const std::string& name) const;
+    TaxonId find(const char* name, size_t len) const;
     std::vector<std::string> names() const;
     const Taxon& operator[] (TaxonId id) const;
 
     std::vector<TaxonId> match(const Regex& re) const;
+    std::vector<TaxonId> match(const Fixed& re) const;
     std::ostream& put(std::ostream& os) const;
 
     typedef std::vector<Taxon>::const_iterator const_iterator;
@@ -70,11 +76,61 @@ public:
     static std::string species_file();
 
 private:
+    struct Snapshot;
+
+    /**
+     * All names and the taxa they name, in a hash table with open
+     * addressing, which can be searched without having the name as
+     * a std::string.
+     */
+    class Table {
+    public:
+	TaxonId find(const char* s, size_t len, unsigned h) const;
+	void insert(const std::string& s, TaxonId id, unsigned h);
+
+	struct Entry {
+	    std::string name;
+	    TaxonId id;
+	};
+	typedef std::vector<Entry>::const_iterator const_iterator;
+	const_iterator begin() const { return v.begin(); }
+	const_iterator end() const { return v.end(); }
+	size_t size() const { return v.size(); }
+
+    private:
+	struct Slot {
+	    unsigned h;
+	    unsigned n;
+	};
+	std::vector<Slot> slots;
+	std::vector<Entry> v;
+    };
+
     std::vector<Taxon> v;
-    std::unordered_map<std::string, TaxonId> m;
+    Table m;
+    std::shared_ptr<const Snapshot> snapshot;
 
+    void parse(std::istream& is, std::ostream& err);
     void map(const Taxon& sp, std::ostream& err);
     void map(const std::string& name, TaxonId id, std::ostream& err);
+
+    bool load(const std::string& path, const std::string& stamp,
+	      std::ostream& err);
+    void save(const std::string& path, const std::string& file,
+	      const std::string& stamp,
+	      const std::string& diagnostics) const;
+    TaxonId indexed(const char* s, size_t len, unsigned h) const;
+    void indexed_names(std::vector<std::string>& acc) const;
 };
 
+
+/**
+ * Find a taxon by name (or scientific name, or alias)
+ * and return its id.  Returns the nil id if not found.
+ */
+inline TaxonId Taxa::find(const std::string& name) const
+{
+    return find(name.data(), name.size());
+}
+
 #endif
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "taxa.h"
+#include "mmap.h"
+#include "replace.h"
+#include "fnv.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/* A snapshot of a species file is, in host byte order:
+ *
+ *   magic        16 octets
+ *   stamp        u64 size, u64 mtime seconds, u64 nanoseconds
+ *   diagnostics  string
+ *   taxa         u32 count, (u32 genus, string name, string latin,
+ *                u32 count, string alias ...) ...
+ *   padding      to a multiple of 4 octets
+ *   index        u32 slots, (u32 name, u32 id) ...
+ *
+ * where a string is a u32 length and the octets.  The stamp is the
+ * species file's, when the snapshot was made from it.  The index is
+ * a hash table of all names, with linear probing. A slot holds the
+ * offset of a string with the name in it, or 0 if it's empty.
+ */
+namespace {
+
+    const char magic[16] = "groblad taxa 1";
+    const size_t stamp_size = 3 * 8;
+
+    /**
+     * "foo/.bar.snapshot" for the species file "foo/bar".
+     */
+    std::string path_of(const std::string& file)
+    {
+	const size_t n = file.rfind('/') + 1;
+	std::string s = file.substr(0, n);
+	s += '.';
+	s.append(file, n, std::string::npos);
+	s += ".snapshot";
+	return s;
+    }
+
+    /**
+     * The size and modification time of 'file', if it's a regular
+     * file; otherwise empty.
+     */
+    std::string stamp(const std::string& file)
+    {
+	struct stat st;
+	if(stat(file.c_str(), &st) || !S_ISREG(st.st_mode)) return "";
+	const uint64_t v[3] = { uint64_t(st.st_size),
+				uint64_t(st.st_mtim.tv_sec),
+				uint64_t(st.st_mtim.tv_nsec) };
+	return std::string(reinterpret_cast<const char*>(v), sizeof v);
+    }
+
+    /**
+     * Reading [p, e) from the front, without reading past e.
+     */
+    struct Reader {
+	Reader(const char* p, const char* e) : p(p), e(e), ok(true) {}
+	const char* p;
+	const char* const e;
+	bool ok;
+
+	const char* take(size_t n) {
+	    if(size_t(e - p) < n) {
+		ok = false;
+		p = e;
+		return 0;
+	    }
+	    const char* q = p;
+	    p += n;
+	    return q;
+	}
+	uint32_t u32() {
+	    uint32_t n = 0;
+	    const char* q = take(sizeof n);
+	    if(q) std::memcpy(&n, q, sizeof n);
+	    return n;
+	}
+	std::string str() {
+	    const uint32_t n = u32();
+	    const char* s = take(n);
+	    return s ? std::string(s, n) : std::string();
+	}
+    };
+
+    void put(std::string& buf, const uint32_t n)
+    {
+	buf.append(reinterpret_cast<const char*>(&n), sizeof n);
+    }
+
+    /**
+     * Put 's', and return where it ended up.
+     */
+    uint32_t put(std::string& buf, const std::string& s)
+    {
+	const uint32_t n = buf.size();
+	put(buf, s.size());
+	buf.append(s);
+	return n;
+    }
+}
+
+
+/**
+ * The names in the snapshot, and where its index is.
+ */
+struct Taxa::Snapshot {
+    Mmap map;
+    const uint32_t* slots;
+    uint32_t n;
+};
+
+
+/**
+ * Like Taxa(is, err), where 'is' reads the species file 'file' --
+ * but if there's an up-to-date snapshot of it, read that instead.
+ * If there isn't, try to make one. It's kept as ".file.snapshot"
+ * next to the file, and is up to date as long as the file has the
+ * same size and modification time as when it was made.
+ */
+Taxa::Taxa(const std::string& file, std::istream& is, std::ostream& err)
+{
+    const std::string path = path_of(file);
+    const std::string st = stamp(file);
+    if(!st.empty() && load(path, st, err)) return;
+
+    std::ostringstream diag;
+    parse(is, diag);
+    err << diag.str();
+    if(!st.empty()) save(path, file, st, diag.str());
+}
+
+
+/**
+ * Helper. Read the snapshot 'path' if it exists and has the right
+ * 'stamp'. Its diagnostics go to 'err'.
+ */
+bool Taxa::load(const std::string& path, const std::string& stamp,
+		std::ostream& err)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd==-1) return false;
+    std::shared_ptr<Snapshot> s(new Snapshot);
+    Mmap m(fd);
+    close(fd);
+    s->map.swap(m);
+
+    const char* const a = s->map.begin();
+    Reader in(a, s->map.end());
+    const char* head = in.take(sizeof magic + stamp_size);
+    if(!head || std::memcmp(head, magic, sizeof magic)) return false;
+    if(std::memcmp(head + sizeof magic, stamp.data(), stamp_size)) return false;
+    const std::string diag = in.str();
+
+    std::vector<Taxon> acc;
+    const uint32_t count = in.u32();
+    if(count > size_t(in.e - in.p)) return false;
+    acc.reserve(count);
+    for(uint32_t n = count; in.ok && n; n--) {
+	const bool genus = in.u32();
+	const std::string name = in.str();
+	const std::string latin = in.str();
+	acc.emplace_back(TaxonId(acc.size() + 1), genus, name, latin);
+	for(uint32_t i = in.u32(); in.ok && i; i--) {
+	    acc.back().add(in.str());
+	}
+    }
+
+    in.take((4 - (in.p - a) % 4) % 4);
+    s->n = in.u32();
+    if(!s->n || s->n & (s->n - 1)) return false;
+    s->slots = reinterpret_cast<const uint32_t*>(in.take(size_t(s->n) * 8));
+    if(!in.ok || in.p!=in.e) return false;
+    bool room = false;
+    for(uint32_t i=0; i<s->n; i++) {
+	const uint32_t offset = s->slots[2*i];
+	if(!offset) {
+	    room = true;
+	    continue;
+	}
+	const uint32_t id = s->slots[2*i + 1];
+	if(!id || id > count) return false;
+	if(offset > s->map.size()) return false;
+	Reader name(a + offset, in.e);
+	name.str();
+	if(!name.ok) return false;
+    }
+    /* or a miss in indexed() would never end */
+    if(!room) return false;
+
+    v.swap(acc);
+    snapshot = s;
+    err << diag;
+    return true;
+}
+
+
+/**
+ * Helper. Write the snapshot 'path' of the species file 'file', if
+ * possible.
+ */
+void Taxa::save(const std::string& path, const std::string& file,
+		const std::string& stamp,
+		const std::string& diagnostics) const
+{
+    std::string b(magic, sizeof magic);
+    b += stamp;
+    ::put(b, diagnostics);
+
+    std::unordered_map<std::string, uint32_t> where;
+    where.reserve(2 * v.size());
+    ::put(b, v.size());
+    for(const Taxon& sp : v) {
+	::put(b, sp.genus);
+	where.insert({sp.name, ::put(b, sp.name)});
+	where.insert({sp.latin, ::put(b, sp.latin)});
+	::put(b, sp.alias.size());
+	for(const std::string& s : sp.alias) {
+	    where.insert({s, ::put(b, s)});
+	}
+    }
+
+    b.append((4 - b.size() % 4) % 4, '\0');
+    uint32_t n = 16;
+    while(n < 2 * m.size()) n *= 2;
+    std::vector<uint32_t> slots(2 * n);
+    for(const auto& item : m) {
+	const std::string& name = item.name;
+	uint32_t i = fnv1a(name.data(), name.size()) & (n - 1);
+	while(slots[2*i]) i = (i + 1) & (n - 1);
+	slots[2*i] = where[name];
+	slots[2*i + 1] = item.id.val;
+    }
+    ::put(b, n);
+    b.append(reinterpret_cast<const char*>(slots.data()),
+	     slots.size() * sizeof slots[0]);
+
+    Replacement f(path, file);
+    f.write(b);
+    f.commit();
+}
+
+
+/**
+ * Helper for find(). The taxon named [name, name+len), with hash
+ * 'h', according to the snapshot's index.
+ */
+TaxonId Taxa::indexed(const char* name, const size_t len,
+		      const unsigned h) const
+{
+    const Snapshot& s = *snapshot;
+    const char* const a = s.map.begin();
+    const uint32_t mask = s.n - 1;
+    uint32_t i = h & mask;
+    while(const uint32_t offset = s.slots[2*i]) {
+	uint32_t n;
+	std::memcpy(&n, a + offset, sizeof n);
+	if(n==len && std::memcmp(a + offset + sizeof n, name, len)==0) {
+	    return TaxonId(s.slots[2*i + 1]);
+	}
+	i = (i + 1) & mask;
+    }
+    return TaxonId();
+}
+
+
+/**
+ * Helper for names().
+ */
+void Taxa::indexed_names(std::vector<std::string>& acc) const
+{
+    const Snapshot& s = *snapshot;
+    const char* const a = s.map.begin();
+    for(uint32_t i=0; i<s.n; i++) {
+	const uint32_t offset = s.slots[2*i];
+	if(!offset) continue;
+	uint32_t len;
+	std::memcpy(&len, a + offset, sizeof len);
+	acc.push_back(std::string(a + offset + sizeof len, len));
+    }
+}
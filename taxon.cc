@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2013 Jrgen Grahn
+ * Copyright (c) 2013 Jörgen Grahn
  * All rights reserved.
  *
  */
 #include "taxon.h"
 #include "regex.h"
+#include "fixed.h"
 
 #include <iostream>
 
@@ -35,14 +36,30 @@ std::ostream& Taxon::put(std::ostream& os) const
 }
 
 
+namespace {
+
+    template<class Re>
+    bool match(const Taxon& sp, const Re& re)
+    {
+	if(re.match(sp.name)) return true;
+	if(re.match(sp.latin)) return true;
+	for(std::vector<std::string>::const_iterator i = sp.alias.begin();
+	    i!=sp.alias.end();
+	    i++) {
+	    if(re.match(*i)) return true;
+	}
+	return false;
+    }
+}
+
+
 bool Taxon::match(const Regex& re) const
 {
-    if(re.match(name)) return true;
-    if(re.match(latin)) return true;
-    for(std::vector<std::string>::const_iterator i = alias.begin();
-	i!=alias.end();
-	i++) {
-	if(re.match(*i)) return true;
-    }
-    return false;
+    return ::match(*this, re);
+}
+
+
+bool Taxon::match(const Fixed& re) const
+{
+    return ::match(*this, re);
 }
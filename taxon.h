@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 1999, 2013, 2020 Jrgen Grahn
+ * Copyright (c) 1999, 2013, 2020 Jörgen Grahn
  * All rights reserved.
  * 
  * Redistribution and use in source and binary forms, with or without
@@ -50,6 +50,7 @@ struct TaxonId {
 
 
 class Regex;
+class Fixed;
 
 /**
  * A species, or taxon in general.
@@ -93,6 +94,7 @@ public:
     std::ostream& put(std::ostream& os) const;
 
     bool match(const Regex& re) const;
+    bool match(const Fixed& re) const;
 
     const TaxonId id;
     const bool genus;
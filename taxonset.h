@@ -0,0 +1,57 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_TAXONSET_H
+#define GROBLAD_TAXONSET_H
+
+#include "taxon.h"
+
+#include <vector>
+#include <cstdint>
+
+
+/**
+ * A set of TaxonIds, as one bit per id.  Made once from a list of
+ * taxa, for asking many excursions if they have one of them: then
+ * each sighting costs a bit test, no matter how many taxa there are.
+ */
+class TaxonSet {
+public:
+    TaxonSet() {}
+    explicit TaxonSet(const std::vector<TaxonId>& taxa);
+
+    void insert(TaxonId id);
+    bool contains(TaxonId id) const;
+    bool empty() const { return v.empty(); }
+
+private:
+    std::vector<uint64_t> v;
+};
+
+
+inline
+TaxonSet::TaxonSet(const std::vector<TaxonId>& taxa)
+{
+    for(TaxonId id : taxa) insert(id);
+}
+
+
+inline
+void TaxonSet::insert(const TaxonId id)
+{
+    const size_t i = id.val / 64;
+    if(i >= v.size()) v.resize(i+1);
+    v[i] |= uint64_t(1) << id.val % 64;
+}
+
+
+inline
+bool TaxonSet::contains(const TaxonId id) const
+{
+    const size_t i = id.val / 64;
+    return i < v.size() && v[i] >> id.val % 64 & 1;
+}
+
+#endif
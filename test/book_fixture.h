@@ -0,0 +1,73 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_TEST_BOOK_FIXTURE_H
+#define GROBLAD_TEST_BOOK_FIXTURE_H
+
+#include <taxa.h>
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * What the tests of reading whole books have in common.
+ */
+namespace fixture {
+
+    /**
+     * The two oaks.
+     */
+    inline Taxa taxa()
+    {
+	std::istringstream iss("bergek  (Quercus petraea)\n"
+			       "skogsek (Quercus robur)\n");
+	std::ostringstream err;
+	return Taxa(iss, err);
+    }
+
+    /**
+     * A book with the text 's', in a temporary directory of its
+     * own.  The directory is removed (with the book's cache) at the
+     * end of the test.
+     */
+    struct Book {
+	explicit Book(const std::string& s)
+	{
+	    char buf[] = "/tmp/groblad.test.XXXXXX";
+	    dir = mkdtemp(buf) ? buf : "/tmp";
+	    name = dir + "/book";
+	    write(s);
+	}
+	~Book()
+	{
+	    std::remove(name.c_str());
+	    forget();
+	    rmdir(dir.c_str());
+	}
+	void write(const std::string& s)
+	{
+	    std::ofstream os(name);
+	    os << s;
+	}
+	void append(const std::string& s)
+	{
+	    std::ofstream os(name, std::ios_base::app);
+	    os << s;
+	}
+	void forget()
+	{
+	    std::remove((dir + "/.book.cache").c_str());
+	    std::remove((dir + "/.book.index").c_str());
+	}
+	std::string dir;
+	std::string name;
+    };
+}
+
+#endif
@@ -0,0 +1,342 @@
+#include <orchis.h>
+#include <iostream>
+namespace book { void add(orchis::TC); }
+namespace book { void duplicate(orchis::TC); }
+namespace book { void empty(orchis::TC); }
+namespace book { void ids(orchis::TC); }
+namespace book { void interned(orchis::TC); }
+namespace book { void large(orchis::TC); }
+namespace book { void same(orchis::TC); }
+namespace cache { void appended(orchis::TC); }
+namespace cache { void appended_only(orchis::TC); }
+namespace cache { void fresh(orchis::TC); }
+namespace cache::index { void find(orchis::TC); }
+namespace cache::index { void only(orchis::TC); }
+namespace cache { void mode(orchis::TC); }
+namespace cache { void not_appended(orchis::TC); }
+namespace cache { void parallel(orchis::TC); }
+namespace cache { void parallel_unfamiliar(orchis::TC); }
+namespace cache { void partial(orchis::TC); }
+namespace cache { void stale(orchis::TC); }
+namespace cache { void stamp(orchis::TC); }
+namespace cache { void standard_input(orchis::TC); }
+namespace chunk { void small(orchis::TC); }
+namespace chunk { void unfamiliar(orchis::TC); }
+namespace chunk { void whole(orchis::TC); }
+namespace comments { void capitalization(orchis::TC); }
+namespace comments { void nil(orchis::TC); }
+namespace comments { void no_taxa(orchis::TC); }
+namespace comments { void non_capitalization(orchis::TC); }
+namespace comments { void one_taxon(orchis::TC); }
+namespace comments { void two_taxa(orchis::TC); }
+namespace comments { void whitespace_taxon(orchis::TC); }
+namespace comments { void whole_words(orchis::TC); }
+namespace cont { void A(orchis::TC); }
+namespace cont { void B(orchis::TC); }
+namespace cont { void C(orchis::TC); }
+namespace cont { void D(orchis::TC); }
+namespace cont { void E(orchis::TC); }
+namespace cont { void F(orchis::TC); }
+namespace cont { void G(orchis::TC); }
+namespace cont { void H(orchis::TC); }
+namespace cont { void I(orchis::TC); }
+namespace cont { void J(orchis::TC); }
+namespace cont { void K(orchis::TC); }
+namespace continuation { void A(orchis::TC); }
+namespace continuation { void B(orchis::TC); }
+namespace continuation { void C(orchis::TC); }
+namespace continuation { void D(orchis::TC); }
+namespace continuation { void E(orchis::TC); }
+namespace continuation { void F(orchis::TC); }
+namespace continuation { void G(orchis::TC); }
+namespace continuation { void H(orchis::TC); }
+namespace continuation { void I(orchis::TC); }
+namespace continuation { void J(orchis::TC); }
+namespace continuation { void K(orchis::TC); }
+namespace continuation { void L(orchis::TC); }
+namespace continuation { void M(orchis::TC); }
+namespace continuation { void N(orchis::TC); }
+namespace continuation { void O(orchis::TC); }
+namespace continuation { void P(orchis::TC); }
+namespace continuation { void R(orchis::TC); }
+namespace cooccurrence { void empty(orchis::TC); }
+namespace cooccurrence { void mixed(orchis::TC); }
+namespace cooccurrence { void simple(orchis::TC); }
+namespace coord { void broken(orchis::TC); }
+namespace coord { void broken2(orchis::TC); }
+namespace coord::rt90 { void northeast(orchis::TC); }
+namespace coord::rt90 { void out_of_range(orchis::TC); }
+namespace coord::rt90 { void southwest(orchis::TC); }
+namespace coord::rt90 { void valid(orchis::TC); }
+namespace coord::sweref99 { void out_of_range(orchis::TC); }
+namespace coord::sweref99 { void valid(orchis::TC); }
+namespace date { void empty(orchis::TC); }
+namespace date { void extra_crud(orchis::TC); }
+namespace date { void missing_stuff(orchis::TC); }
+namespace date { void old_formats(orchis::TC); }
+namespace date::print { void empty(orchis::TC); }
+namespace date::print { void extra_crud(orchis::TC); }
+namespace date::print { void missing_stuff(orchis::TC); }
+namespace date::print { void old_formats(orchis::TC); }
+namespace date::print { void simple(orchis::TC); }
+namespace date { void simple(orchis::TC); }
+namespace encoding { void ascii(orchis::TC); }
+namespace encoding::bad { void latin1(orchis::TC); }
+namespace encoding::bad { void latin1_trailer(orchis::TC); }
+namespace encoding::bad { void not_minimal(orchis::TC); }
+namespace encoding::bad { void trailing_partial(orchis::TC); }
+namespace encoding { void bits11(orchis::TC); }
+namespace encoding { void bits16(orchis::TC); }
+namespace encoding { void bits21(orchis::TC); }
+namespace encoding { void bits26(orchis::TC); }
+namespace encoding { void bits31(orchis::TC); }
+namespace encoding { void list(orchis::TC); }
+namespace encoding { void narrowing(orchis::TC); }
+namespace fieldview { void assign(orchis::TC); }
+namespace fieldview { void continuation(orchis::TC); }
+namespace fieldview { void known(orchis::TC); }
+namespace fieldview { void same(orchis::TC); }
+namespace fieldview { void skipped(orchis::TC); }
+namespace fieldview { void text(orchis::TC); }
+namespace files { void boundaries(orchis::TC); }
+namespace files { void empty(orchis::TC); }
+namespace files { void long_line(orchis::TC); }
+namespace files { void long_line_mapped(orchis::TC); }
+namespace files { void no_newline(orchis::TC); }
+namespace files { void not_exhausted(orchis::TC); }
+namespace files { void nothing(orchis::TC); }
+namespace files { void pipe(orchis::TC); }
+namespace files { void several(orchis::TC); }
+namespace files { void simple(orchis::TC); }
+namespace files { void standard_input(orchis::TC); }
+namespace fixed { void ascii(orchis::TC); }
+namespace fixed { void latin1(orchis::TC); }
+namespace fixed { void literals(orchis::TC); }
+namespace fixed { void long_text(orchis::TC); }
+namespace fixed { void regex(orchis::TC); }
+namespace fixed { void simple(orchis::TC); }
+namespace fixed { void utf8(orchis::TC); }
+namespace ftest { void not_readable(orchis::TC); }
+namespace ftest { void readable(orchis::TC); }
+namespace grep { void inverted(orchis::TC); }
+namespace grep { void missing_pattern(orchis::TC); }
+namespace grep { void pattern_file(orchis::TC); }
+namespace grep { void prefilter(orchis::TC); }
+namespace grep { void routing(orchis::TC); }
+namespace grep { void taxa_only(orchis::TC); }
+namespace indent::left { void test_0(orchis::TC); }
+namespace indent::left { void test_1(orchis::TC); }
+namespace indent::left { void test_2(orchis::TC); }
+namespace indent::left { void test_7(orchis::TC); }
+namespace indent::left { void test_8(orchis::TC); }
+namespace indent::left { void test_9(orchis::TC); }
+namespace indent::measure { void ascii(orchis::TC); }
+namespace indent::measure { void fallback(orchis::TC); }
+namespace indent::measure { void latin1(orchis::TC); }
+namespace indent::measure { void null(orchis::TC); }
+namespace indent::measure { void utf8(orchis::TC); }
+namespace indent::right { void test_0(orchis::TC); }
+namespace indent::right { void test_1(orchis::TC); }
+namespace indent { void simple(orchis::TC); }
+namespace lineparse { void find(orchis::TC); }
+namespace lineparse { void left(orchis::TC); }
+namespace lineparse { void non_space(orchis::TC); }
+namespace lineparse { void right(orchis::TC); }
+namespace regex { void bracket(orchis::TC); }
+namespace regex { void escaped(orchis::TC); }
+namespace regex { void quantified(orchis::TC); }
+namespace regex { void range(orchis::TC); }
+namespace regex { void simple(orchis::TC); }
+namespace spill { void empty(orchis::TC); }
+namespace spill { void exact(orchis::TC); }
+namespace spill { void in_memory(orchis::TC); }
+namespace spill { void many_runs(orchis::TC); }
+namespace spill { void runs(orchis::TC); }
+namespace spsc { void empty(orchis::TC); }
+namespace spsc { void end_of_stream(orchis::TC); }
+namespace spsc { void full(orchis::TC); }
+namespace spsc { void order(orchis::TC); }
+namespace taxa { void alias(orchis::TC); }
+namespace taxa { void common_only(orchis::TC); }
+namespace taxa { void empty(orchis::TC); }
+namespace taxa { void explicit_genus(orchis::TC); }
+namespace taxa { void find_range(orchis::TC); }
+namespace taxa { void scientific_only(orchis::TC); }
+namespace taxa { void snapshot(orchis::TC); }
+namespace taxa { void snapshot_corrupt(orchis::TC); }
+namespace taxa { void snapshot_stale(orchis::TC); }
+namespace taxa { void two(orchis::TC); }
+namespace taxonset { void empty(orchis::TC); }
+namespace taxonset { void has_one(orchis::TC); }
+namespace taxonset { void some(orchis::TC); }
+int main() { int bad=0, n=0;
+  try { n++; book::add(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::add: " << e.s << '\n'; }
+  try { n++; book::duplicate(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::duplicate: " << e.s << '\n'; }
+  try { n++; book::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::empty: " << e.s << '\n'; }
+  try { n++; book::ids(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::ids: " << e.s << '\n'; }
+  try { n++; book::interned(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::interned: " << e.s << '\n'; }
+  try { n++; book::large(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::large: " << e.s << '\n'; }
+  try { n++; book::same(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL book::same: " << e.s << '\n'; }
+  try { n++; cache::appended(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::appended: " << e.s << '\n'; }
+  try { n++; cache::appended_only(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::appended_only: " << e.s << '\n'; }
+  try { n++; cache::fresh(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::fresh: " << e.s << '\n'; }
+  try { n++; cache::index::find(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::index::find: " << e.s << '\n'; }
+  try { n++; cache::index::only(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::index::only: " << e.s << '\n'; }
+  try { n++; cache::mode(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::mode: " << e.s << '\n'; }
+  try { n++; cache::not_appended(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::not_appended: " << e.s << '\n'; }
+  try { n++; cache::parallel(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::parallel: " << e.s << '\n'; }
+  try { n++; cache::parallel_unfamiliar(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::parallel_unfamiliar: " << e.s << '\n'; }
+  try { n++; cache::partial(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::partial: " << e.s << '\n'; }
+  try { n++; cache::stale(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::stale: " << e.s << '\n'; }
+  try { n++; cache::stamp(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::stamp: " << e.s << '\n'; }
+  try { n++; cache::standard_input(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cache::standard_input: " << e.s << '\n'; }
+  try { n++; chunk::small(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL chunk::small: " << e.s << '\n'; }
+  try { n++; chunk::unfamiliar(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL chunk::unfamiliar: " << e.s << '\n'; }
+  try { n++; chunk::whole(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL chunk::whole: " << e.s << '\n'; }
+  try { n++; comments::capitalization(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::capitalization: " << e.s << '\n'; }
+  try { n++; comments::nil(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::nil: " << e.s << '\n'; }
+  try { n++; comments::no_taxa(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::no_taxa: " << e.s << '\n'; }
+  try { n++; comments::non_capitalization(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::non_capitalization: " << e.s << '\n'; }
+  try { n++; comments::one_taxon(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::one_taxon: " << e.s << '\n'; }
+  try { n++; comments::two_taxa(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::two_taxa: " << e.s << '\n'; }
+  try { n++; comments::whitespace_taxon(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::whitespace_taxon: " << e.s << '\n'; }
+  try { n++; comments::whole_words(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL comments::whole_words: " << e.s << '\n'; }
+  try { n++; cont::A(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::A: " << e.s << '\n'; }
+  try { n++; cont::B(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::B: " << e.s << '\n'; }
+  try { n++; cont::C(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::C: " << e.s << '\n'; }
+  try { n++; cont::D(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::D: " << e.s << '\n'; }
+  try { n++; cont::E(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::E: " << e.s << '\n'; }
+  try { n++; cont::F(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::F: " << e.s << '\n'; }
+  try { n++; cont::G(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::G: " << e.s << '\n'; }
+  try { n++; cont::H(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::H: " << e.s << '\n'; }
+  try { n++; cont::I(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::I: " << e.s << '\n'; }
+  try { n++; cont::J(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::J: " << e.s << '\n'; }
+  try { n++; cont::K(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cont::K: " << e.s << '\n'; }
+  try { n++; continuation::A(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::A: " << e.s << '\n'; }
+  try { n++; continuation::B(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::B: " << e.s << '\n'; }
+  try { n++; continuation::C(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::C: " << e.s << '\n'; }
+  try { n++; continuation::D(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::D: " << e.s << '\n'; }
+  try { n++; continuation::E(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::E: " << e.s << '\n'; }
+  try { n++; continuation::F(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::F: " << e.s << '\n'; }
+  try { n++; continuation::G(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::G: " << e.s << '\n'; }
+  try { n++; continuation::H(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::H: " << e.s << '\n'; }
+  try { n++; continuation::I(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::I: " << e.s << '\n'; }
+  try { n++; continuation::J(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::J: " << e.s << '\n'; }
+  try { n++; continuation::K(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::K: " << e.s << '\n'; }
+  try { n++; continuation::L(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::L: " << e.s << '\n'; }
+  try { n++; continuation::M(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::M: " << e.s << '\n'; }
+  try { n++; continuation::N(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::N: " << e.s << '\n'; }
+  try { n++; continuation::O(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::O: " << e.s << '\n'; }
+  try { n++; continuation::P(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::P: " << e.s << '\n'; }
+  try { n++; continuation::R(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL continuation::R: " << e.s << '\n'; }
+  try { n++; cooccurrence::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cooccurrence::empty: " << e.s << '\n'; }
+  try { n++; cooccurrence::mixed(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cooccurrence::mixed: " << e.s << '\n'; }
+  try { n++; cooccurrence::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL cooccurrence::simple: " << e.s << '\n'; }
+  try { n++; coord::broken(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::broken: " << e.s << '\n'; }
+  try { n++; coord::broken2(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::broken2: " << e.s << '\n'; }
+  try { n++; coord::rt90::northeast(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::rt90::northeast: " << e.s << '\n'; }
+  try { n++; coord::rt90::out_of_range(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::rt90::out_of_range: " << e.s << '\n'; }
+  try { n++; coord::rt90::southwest(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::rt90::southwest: " << e.s << '\n'; }
+  try { n++; coord::rt90::valid(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::rt90::valid: " << e.s << '\n'; }
+  try { n++; coord::sweref99::out_of_range(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::sweref99::out_of_range: " << e.s << '\n'; }
+  try { n++; coord::sweref99::valid(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL coord::sweref99::valid: " << e.s << '\n'; }
+  try { n++; date::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::empty: " << e.s << '\n'; }
+  try { n++; date::extra_crud(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::extra_crud: " << e.s << '\n'; }
+  try { n++; date::missing_stuff(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::missing_stuff: " << e.s << '\n'; }
+  try { n++; date::old_formats(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::old_formats: " << e.s << '\n'; }
+  try { n++; date::print::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::print::empty: " << e.s << '\n'; }
+  try { n++; date::print::extra_crud(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::print::extra_crud: " << e.s << '\n'; }
+  try { n++; date::print::missing_stuff(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::print::missing_stuff: " << e.s << '\n'; }
+  try { n++; date::print::old_formats(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::print::old_formats: " << e.s << '\n'; }
+  try { n++; date::print::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::print::simple: " << e.s << '\n'; }
+  try { n++; date::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL date::simple: " << e.s << '\n'; }
+  try { n++; encoding::ascii(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::ascii: " << e.s << '\n'; }
+  try { n++; encoding::bad::latin1(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bad::latin1: " << e.s << '\n'; }
+  try { n++; encoding::bad::latin1_trailer(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bad::latin1_trailer: " << e.s << '\n'; }
+  try { n++; encoding::bad::not_minimal(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bad::not_minimal: " << e.s << '\n'; }
+  try { n++; encoding::bad::trailing_partial(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bad::trailing_partial: " << e.s << '\n'; }
+  try { n++; encoding::bits11(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bits11: " << e.s << '\n'; }
+  try { n++; encoding::bits16(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bits16: " << e.s << '\n'; }
+  try { n++; encoding::bits21(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bits21: " << e.s << '\n'; }
+  try { n++; encoding::bits26(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bits26: " << e.s << '\n'; }
+  try { n++; encoding::bits31(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::bits31: " << e.s << '\n'; }
+  try { n++; encoding::list(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::list: " << e.s << '\n'; }
+  try { n++; encoding::narrowing(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL encoding::narrowing: " << e.s << '\n'; }
+  try { n++; fieldview::assign(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::assign: " << e.s << '\n'; }
+  try { n++; fieldview::continuation(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::continuation: " << e.s << '\n'; }
+  try { n++; fieldview::known(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::known: " << e.s << '\n'; }
+  try { n++; fieldview::same(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::same: " << e.s << '\n'; }
+  try { n++; fieldview::skipped(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::skipped: " << e.s << '\n'; }
+  try { n++; fieldview::text(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fieldview::text: " << e.s << '\n'; }
+  try { n++; files::boundaries(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::boundaries: " << e.s << '\n'; }
+  try { n++; files::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::empty: " << e.s << '\n'; }
+  try { n++; files::long_line(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::long_line: " << e.s << '\n'; }
+  try { n++; files::long_line_mapped(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::long_line_mapped: " << e.s << '\n'; }
+  try { n++; files::no_newline(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::no_newline: " << e.s << '\n'; }
+  try { n++; files::not_exhausted(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::not_exhausted: " << e.s << '\n'; }
+  try { n++; files::nothing(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::nothing: " << e.s << '\n'; }
+  try { n++; files::pipe(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::pipe: " << e.s << '\n'; }
+  try { n++; files::several(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::several: " << e.s << '\n'; }
+  try { n++; files::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::simple: " << e.s << '\n'; }
+  try { n++; files::standard_input(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL files::standard_input: " << e.s << '\n'; }
+  try { n++; fixed::ascii(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::ascii: " << e.s << '\n'; }
+  try { n++; fixed::latin1(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::latin1: " << e.s << '\n'; }
+  try { n++; fixed::literals(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::literals: " << e.s << '\n'; }
+  try { n++; fixed::long_text(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::long_text: " << e.s << '\n'; }
+  try { n++; fixed::regex(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::regex: " << e.s << '\n'; }
+  try { n++; fixed::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::simple: " << e.s << '\n'; }
+  try { n++; fixed::utf8(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL fixed::utf8: " << e.s << '\n'; }
+  try { n++; ftest::not_readable(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL ftest::not_readable: " << e.s << '\n'; }
+  try { n++; ftest::readable(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL ftest::readable: " << e.s << '\n'; }
+  try { n++; grep::inverted(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::inverted: " << e.s << '\n'; }
+  try { n++; grep::missing_pattern(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::missing_pattern: " << e.s << '\n'; }
+  try { n++; grep::pattern_file(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::pattern_file: " << e.s << '\n'; }
+  try { n++; grep::prefilter(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::prefilter: " << e.s << '\n'; }
+  try { n++; grep::routing(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::routing: " << e.s << '\n'; }
+  try { n++; grep::taxa_only(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL grep::taxa_only: " << e.s << '\n'; }
+  try { n++; indent::left::test_0(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_0: " << e.s << '\n'; }
+  try { n++; indent::left::test_1(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_1: " << e.s << '\n'; }
+  try { n++; indent::left::test_2(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_2: " << e.s << '\n'; }
+  try { n++; indent::left::test_7(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_7: " << e.s << '\n'; }
+  try { n++; indent::left::test_8(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_8: " << e.s << '\n'; }
+  try { n++; indent::left::test_9(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::left::test_9: " << e.s << '\n'; }
+  try { n++; indent::measure::ascii(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::measure::ascii: " << e.s << '\n'; }
+  try { n++; indent::measure::fallback(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::measure::fallback: " << e.s << '\n'; }
+  try { n++; indent::measure::latin1(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::measure::latin1: " << e.s << '\n'; }
+  try { n++; indent::measure::null(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::measure::null: " << e.s << '\n'; }
+  try { n++; indent::measure::utf8(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::measure::utf8: " << e.s << '\n'; }
+  try { n++; indent::right::test_0(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::right::test_0: " << e.s << '\n'; }
+  try { n++; indent::right::test_1(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::right::test_1: " << e.s << '\n'; }
+  try { n++; indent::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL indent::simple: " << e.s << '\n'; }
+  try { n++; lineparse::find(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL lineparse::find: " << e.s << '\n'; }
+  try { n++; lineparse::left(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL lineparse::left: " << e.s << '\n'; }
+  try { n++; lineparse::non_space(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL lineparse::non_space: " << e.s << '\n'; }
+  try { n++; lineparse::right(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL lineparse::right: " << e.s << '\n'; }
+  try { n++; regex::bracket(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL regex::bracket: " << e.s << '\n'; }
+  try { n++; regex::escaped(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL regex::escaped: " << e.s << '\n'; }
+  try { n++; regex::quantified(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL regex::quantified: " << e.s << '\n'; }
+  try { n++; regex::range(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL regex::range: " << e.s << '\n'; }
+  try { n++; regex::simple(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL regex::simple: " << e.s << '\n'; }
+  try { n++; spill::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spill::empty: " << e.s << '\n'; }
+  try { n++; spill::exact(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spill::exact: " << e.s << '\n'; }
+  try { n++; spill::in_memory(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spill::in_memory: " << e.s << '\n'; }
+  try { n++; spill::many_runs(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spill::many_runs: " << e.s << '\n'; }
+  try { n++; spill::runs(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spill::runs: " << e.s << '\n'; }
+  try { n++; spsc::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spsc::empty: " << e.s << '\n'; }
+  try { n++; spsc::end_of_stream(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spsc::end_of_stream: " << e.s << '\n'; }
+  try { n++; spsc::full(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spsc::full: " << e.s << '\n'; }
+  try { n++; spsc::order(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL spsc::order: " << e.s << '\n'; }
+  try { n++; taxa::alias(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::alias: " << e.s << '\n'; }
+  try { n++; taxa::common_only(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::common_only: " << e.s << '\n'; }
+  try { n++; taxa::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::empty: " << e.s << '\n'; }
+  try { n++; taxa::explicit_genus(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::explicit_genus: " << e.s << '\n'; }
+  try { n++; taxa::find_range(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::find_range: " << e.s << '\n'; }
+  try { n++; taxa::scientific_only(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::scientific_only: " << e.s << '\n'; }
+  try { n++; taxa::snapshot(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::snapshot: " << e.s << '\n'; }
+  try { n++; taxa::snapshot_corrupt(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::snapshot_corrupt: " << e.s << '\n'; }
+  try { n++; taxa::snapshot_stale(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::snapshot_stale: " << e.s << '\n'; }
+  try { n++; taxa::two(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxa::two: " << e.s << '\n'; }
+  try { n++; taxonset::empty(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxonset::empty: " << e.s << '\n'; }
+  try { n++; taxonset::has_one(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxonset::has_one: " << e.s << '\n'; }
+  try { n++; taxonset::some(orchis::TC()); } catch(orchis::Failure& e) { bad++; std::cout << "FAIL taxonset::some: " << e.s << '\n'; }
+  std::cout << n-bad << "/" << n << " OK\n"; return bad!=0; }
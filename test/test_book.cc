@@ -0,0 +1,198 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <book.h>
+#include <files...h>
+#include <taxa.h>
+
+#include <string>
+#include <sstream>
+#include <cstring>
+
+#include <orchis.h>
+
+namespace {
+
+    Taxa taxa()
+    {
+	std::istringstream iss("bergek  (Quercus petraea)\n"
+			       "skogsek (Quercus robur)\n");
+	std::ostringstream err;
+	return Taxa(iss, err);
+    }
+
+    const char text[] =
+	"{\n"
+	"place : foo\n"
+	"        bar\n"
+	"date  : 2020-05-17\n"
+	"}{\n"
+	"bergek  :#: one\n"
+	"skogsek :#:\n"
+	"}\n"
+	"{\n"
+	"place : baz\n"
+	"}{\n"
+	"skogsek :#: two\n"
+	"            three\n"
+	"}\n";
+
+    /**
+     * All of 'text', as FieldLists into 'a' and views into 'b'.
+     */
+    void read(Book& a, Book& b)
+    {
+	Taxa spp = taxa();
+	std::ostringstream err;
+	{
+	    const Files::Segment seg {{"book", 1}, text, text + sizeof text - 1};
+	    Files is({seg});
+	    Excursion ex;
+	    while(get(is, err, spp, ex)) a.add(ex);
+	}
+	{
+	    const Files::Segment seg {{"book", 1}, text, text + sizeof text - 1};
+	    Files is({seg});
+	    FieldView ex;
+	    while(get(is, err, spp, ex)) b.add(ex);
+	}
+    }
+
+    std::string str(const Book& book)
+    {
+	std::ostringstream oss;
+	for(const Book::Entry& ex : book) oss << ex;
+	return oss.str();
+    }
+}
+
+namespace book {
+
+    using orchis::TC;
+
+    void empty(TC)
+    {
+	const Book book;
+	orchis::assert_true(book.empty());
+	orchis::assert_true(book.begin()==book.end());
+    }
+
+    void add(TC)
+    {
+	Book a;
+	Book b;
+	read(a, b);
+	orchis::assert_eq(a.size(), 2);
+	orchis::assert_eq(b.size(), 2);
+	orchis::assert_eq(str(a), str(b));
+
+	const Book::Entry ex = b[1];
+	orchis::assert_eq(ex.place.str(), "baz");
+	orchis::assert_eq(ex.send() - ex.sbegin(), 1);
+	orchis::assert_eq(ex.sbegin()->comment.str(), "two\nthree");
+	orchis::assert_true(ex.sbegin()->comment.simple());
+	orchis::assert_eq(b[0].find_header("place").str(), "foo\nbar");
+	orchis::assert_eq(b[0].date.value(), 20200517);
+    }
+
+    void same(TC)
+    {
+	Book a;
+	Book b;
+	read(a, b);
+
+	Taxa spp = taxa();
+	std::ostringstream err;
+	const Files::Segment seg {{"book", 1}, text, text + sizeof text - 1};
+	Files is({seg});
+	Excursion ex;
+	std::ostringstream oss;
+	while(get(is, err, spp, ex)) oss << ex;
+	orchis::assert_eq(str(a), oss.str());
+    }
+
+    void ids(TC)
+    {
+	Book a;
+	Book b;
+	read(a, b);
+
+	const Book::Entry ex = b[0];
+	orchis::assert_eq(ex.tend() - ex.tbegin(), 2);
+	orchis::assert_true(ex.tbegin()[0] < ex.tbegin()[1]);
+	orchis::assert_true(ex.contains(ex.tbegin()[1]));
+	orchis::assert_false(b[1].contains(ex.tbegin()[0]));
+	orchis::assert_true(b[1].contains(ex.tbegin()[1]));
+	orchis::assert_true(b[1].has_one(std::vector<TaxonId>{TaxonId(7), ex.tbegin()[1]}));
+	orchis::assert_false(b[1].has_one(std::vector<TaxonId>()));
+	orchis::assert_false(b[1].coordinate.valid());
+	orchis::assert_true(b[1].header(header::COORDINATE).empty());
+    }
+
+    void interned(TC)
+    {
+	Book book;
+	for(const char* place : {"foo", "bar", "foo"}) {
+	    FieldList ex;
+	    ex.add_header("place", 5, place, std::strlen(place));
+	    ex.add_header("observers", 9, "JoG", 3);
+	    ex.finalize();
+	    book.add(ex);
+	}
+	orchis::assert_eq(book[0].place_id, book[2].place_id);
+	orchis::assert_true(book[0].place_id != book[1].place_id);
+	orchis::assert_true(book[0].place.a == book[2].place.a);
+	orchis::assert_eq(book[2].place.str(), "foo");
+	orchis::assert_eq(book[1].find_header("observers").str(), "JoG");
+	orchis::assert_true(book[1].has_header("observers"));
+	orchis::assert_false(book[1].has_header("date"));
+	orchis::assert_eq(book[1].find_header("date").str(), "");
+	orchis::assert_eq(book[1].hbegin()->name.str(), "place");
+
+	for(unsigned i=0; i<200; i++) {
+	    const std::string place = std::to_string(i);
+	    FieldList ex;
+	    ex.add_header("place", 5, place.data(), place.size());
+	    ex.finalize();
+	    book.add(ex);
+	}
+	orchis::assert_eq(book[3 + 117].place.str(), "117");
+	orchis::assert_eq(book[0].place_id, book[2].place_id);
+    }
+
+    /**
+     * Like a FieldList, the first of two places counts -- also if
+     * it's empty.
+     */
+    void duplicate(TC)
+    {
+	for(const char* first : {"", "Lund"}) {
+	    FieldList ex;
+	    ex.add_header("place", 5, first, std::strlen(first));
+	    ex.add_header("place", 5, "Haga", 4);
+	    ex.finalize();
+	    Book book;
+	    book.add(ex);
+	    orchis::assert_eq(book[0].place.str(), first);
+	    orchis::assert_eq(book[0].place.str(), ex.find_header("place"));
+	}
+    }
+
+    void large(TC)
+    {
+	const std::string s(3 << 20, 'x');
+	FieldList ex;
+	ex.add_header("place", 5, s.data(), s.size());
+	ex.add_header("date", 4, "", 0);
+	ex.finalize();
+
+	Book book;
+	book.add(ex);
+	book.add(ex);
+	orchis::assert_eq(book[0].place.n, s.size());
+	orchis::assert_eq(book[1].place.str(), s);
+	book.clear();
+	orchis::assert_true(book.empty());
+    }
+}
@@ -0,0 +1,428 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <cache.h>
+#include <parser.h>
+#include <files...h>
+#include <excursion.h>
+#include <taxa.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include <orchis.h>
+
+#include "book_fixture.h"
+
+namespace {
+
+    using fixture::taxa;
+    using fixture::Book;
+
+    /**
+     * All excursions and diagnostics in 'book', as text.
+     */
+    std::string read(const Book& book, Taxa& spp, unsigned jobs = 1,
+		     const std::vector<std::string>& only = {})
+    {
+	const std::vector<std::string> v{book.name};
+	Files files(begin(v), end(v));
+	std::ostringstream oss;
+	Parser parser(files, oss, spp, jobs);
+	if(!only.empty()) {
+	    std::vector<TaxonId> taxa;
+	    for(const std::string& name : only) {
+		taxa.push_back(spp.find(name));
+	    }
+	    parser.only(taxa);
+	}
+	Excursion ex;
+	while(parser.get(ex)) {
+	    oss << ex << '\n';
+	}
+	return oss.str();
+    }
+
+    const char text[] =
+	"{\n"
+	"place: foo\n"
+	"date: 2026-05-01\n"
+	"}{\n"
+	"bergek :#:\n"
+	"okand  :#: hej\n"
+	"}\n"
+	"\n"
+	"garbage\n"
+	"{\n"
+	"place: bar\n"
+	"}{\n"
+	"skogsek :#: hej\n"
+	"        du\n"
+	"okand   :#:\n"
+	"}\n";
+}
+
+namespace cache {
+
+    using orchis::TC;
+    using orchis::assert_eq;
+    using orchis::assert_true;
+    using orchis::assert_false;
+
+    void fresh(TC)
+    {
+	const Book book(text);
+	assert_false(Cache(book.name).fresh());
+
+	Taxa spp = taxa();
+	const std::string s = read(book, spp);
+	assert_true(Cache(book.name).fresh());
+
+	Taxa spp2 = taxa();
+	assert_eq(read(book, spp2), s);
+	assert_true(spp2.find("okand"));
+    }
+
+    void stale(TC)
+    {
+	Book book(text);
+	Taxa spp = taxa();
+	read(book, spp);
+
+	book.write("{\n"
+		   "place: baz\n"
+		   "}{\n"
+		   "}\n");
+	assert_false(Cache(book.name).fresh());
+	Taxa spp2 = taxa();
+	assert_eq(read(book, spp2),
+		  "{\n"
+		  "place : baz\n"
+		  "}{\n"
+		  "}\n"
+		  "\n");
+    }
+
+    void parallel(TC)
+    {
+	const Book book(text);
+	Taxa spp = taxa();
+	const std::string s = read(book, spp);
+
+	for(unsigned jobs : {1, 3, 1}) {
+	    Taxa spp2 = taxa();
+	    assert_eq(read(book, spp2, jobs), s);
+	    assert_true(Cache(book.name).fresh());
+	}
+    }
+
+    /**
+     * A book of several Parser chunks, with diagnostics all over,
+     * and unfamiliar taxa which show up again later.
+     */
+    std::string big()
+    {
+	std::ostringstream oss;
+	for(unsigned i=0; i<60000; i++) {
+	    oss << "{\n"
+		<< "place: p" << i << "\n"
+		<< "}{\n"
+		<< "bergek :#:\n";
+	    if(i%500==0) oss << "okand" << i/500%20 << " :#:\n";
+	    oss << "}\n";
+	    if(i%700==0) oss << "garbage\n";
+	}
+	return oss.str();
+    }
+
+    void parallel_unfamiliar(TC)
+    {
+	Book book(big());
+	Taxa spp = taxa();
+	const std::string s = read(book, spp);
+
+	for(unsigned jobs : {2, 4}) {
+	    book.forget();
+	    Taxa spp2 = taxa();
+	    assert_eq(read(book, spp2, jobs), s);
+	    for(unsigned i=0; i<20; i++) {
+		const std::string name = "okand" + std::to_string(i);
+		assert_eq(spp2.find(name), spp.find(name));
+	    }
+	}
+    }
+
+    void partial(TC)
+    {
+	const Book book("{\n"
+			"place: foo\n"
+			"}{\n"
+			"}\n"
+			"{\n");
+	Taxa spp = taxa();
+	read(book, spp);
+	assert_false(Cache(book.name).fresh());
+    }
+
+    void appended(TC)
+    {
+	const char more[] =
+	    "\n"
+	    "{\n"
+	    "place: baz\n"
+	    "}{\n"
+	    "bergek  :#:\n"
+	    "okand2  :#:\n"
+	    "okand   :#:\n"
+	    "}\n";
+
+	for(unsigned jobs : {1, 3}) {
+	    Book book(text);
+	    Taxa spp = taxa();
+	    read(book, spp, jobs);
+	    book.append(more);
+
+	    Cache cache(book.name);
+	    assert_false(cache.fresh());
+	    assert_true(cache.appended());
+	    assert_eq(cache.length(), sizeof text - 1);
+	    assert_eq(cache.lines(), 16);
+
+	    Taxa spp2 = taxa();
+	    const std::string s = read(book, spp2, jobs);
+	    assert_true(Cache(book.name).fresh());
+	    Cache cache2(book.name);
+	    const Index ix(cache2);
+	    assert_true(ix.valid());
+	    assert_eq(ix.size(), 3);
+	    assert_eq(ix.offset(2), sizeof text - 1);
+	    assert_eq(ix.line(2), 17);
+	    assert_eq(ix.invented().size(), 2);
+	    assert_eq(ix.invented()[1].first, 2);
+	    assert_true(ix.find({spp2.find("bergek")}) ==
+			(std::vector<unsigned>{0, 2}));
+
+	    book.forget();
+	    Taxa spp3 = taxa();
+	    assert_eq(read(book, spp3, jobs), s);
+	}
+    }
+
+    void appended_only(TC)
+    {
+	Book book(text);
+	Taxa spp = taxa();
+	read(book, spp);
+	book.append("{\n"
+		    "place: baz\n"
+		    "}{\n"
+		    "skogsek :#:\n"
+		    "}\n");
+
+	Taxa spp2 = taxa();
+	assert_eq(read(book, spp2, 1, {"skogsek"}),
+		  book.name + ":9: parse error: garbage\n"
+		  "{\n"
+		  "place : bar\n"
+		  "}{\n"
+		  "skogsek\t\t:#: hej\n"
+		  "\t\t    du\n"
+		  "okand\t\t:#: \n"
+		  "}\n"
+		  "\n"
+		  "{\n"
+		  "place : baz\n"
+		  "}{\n"
+		  "skogsek\t\t:#: \n"
+		  "}\n"
+		  "\n");
+	assert_true(Cache(book.name).fresh());
+    }
+
+    void not_appended(TC)
+    {
+	Book book(text);
+	Taxa spp = taxa();
+	read(book, spp);
+	book.write(std::string(text) + "{\n");
+	assert_true(Cache(book.name).appended());
+	Taxa spp2 = taxa();
+	read(book, spp2);
+	assert_false(Cache(book.name).fresh());
+	assert_true(Cache(book.name).appended());
+
+	book.write(std::string(text, sizeof text - 2) + "{\n");
+	assert_false(Cache(book.name).appended());
+    }
+
+    /**
+     * Set the modification time of 'book' to 'sec' seconds since
+     * the epoch.
+     */
+    void backdate(const Book& book, const time_t sec)
+    {
+	const struct timespec ts[2] = {{sec, 0}, {sec, 0}};
+	assert_eq(utimensat(AT_FDCWD, book.name.c_str(), ts, 0), 0);
+    }
+
+    void stamp(TC)
+    {
+	Book book(text);
+	Taxa spp = taxa();
+	read(book, spp);
+	assert_true(Cache(book.name).fresh());
+
+	/* too recent to trust the stamp, but it's still the same text */
+	book.write(text);
+	assert_true(Cache(book.name).fresh());
+
+	backdate(book, 1000000000);
+	book.forget();
+	read(book, spp);
+
+	/* not hashed, since it still has the stamp */
+	std::string s = text;
+	s[0] = '#';
+	book.write(s);
+	backdate(book, 1000000000);
+	assert_true(Cache(book.name).fresh());
+
+	backdate(book, 1000000001);
+	assert_false(Cache(book.name).fresh());
+    }
+
+    /**
+     * The cache and index may be read by whoever may read the book,
+     * and no one else.
+     */
+    void mode(TC)
+    {
+	Book book(text);
+	struct stat st;
+	for(mode_t m : {0600, 0640, 0664}) {
+	    book.forget();
+	    assert_eq(chmod(book.name.c_str(), m), 0);
+	    const mode_t mask = umask(022);
+	    Taxa spp = taxa();
+	    read(book, spp);
+	    umask(mask);
+
+	    assert_eq(stat((book.dir + "/.book.cache").c_str(), &st), 0);
+	    assert_eq(st.st_mode & 0777, m & ~022);
+	    assert_eq(stat((book.dir + "/.book.index").c_str(), &st), 0);
+	    assert_eq(st.st_mode & 0777, m & ~022);
+	}
+    }
+
+    void standard_input(TC)
+    {
+	const Book book(text);
+	char cwd[4096];
+	assert_true(getcwd(cwd, sizeof cwd));
+	assert_eq(chdir(book.dir.c_str()), 0);
+	{
+	    std::ofstream os("-");
+	    os << text;
+	}
+
+	Taxa spp = taxa();
+	{
+	    Cache c("-");
+	    Cache::Writer w(c, spp);
+	    assert_false(w.commit());
+	}
+	assert_false(Cache("-").fresh());
+	struct stat st;
+	assert_true(stat(".-.cache", &st) == -1);
+
+	std::remove("-");
+	std::remove(".-.cache");
+	std::remove(".-.index");
+	assert_eq(chdir(cwd), 0);
+    }
+
+    namespace index {
+
+	void find(TC)
+	{
+	    const Book book(text);
+	    Taxa spp = taxa();
+	    read(book, spp);
+
+	    Cache cache(book.name);
+	    const Index ix(cache);
+	    assert_true(ix.valid());
+	    assert_true(ix.fits(taxa()));
+	    assert_eq(ix.size(), 2);
+	    assert_eq(ix.taxa(), 3);
+	    assert_eq(ix.offset(0), 0);
+	    assert_eq(ix.line(0), 1);
+	    assert_eq(ix.line(1), 9);
+	    assert_eq(std::string(text + ix.offset(1), 8), "garbage\n");
+
+	    const TaxonId bergek = spp.find("bergek");
+	    const TaxonId skogsek = spp.find("skogsek");
+	    assert_true(ix.find({bergek}) == std::vector<unsigned>{0});
+	    assert_true(ix.find({skogsek}) == std::vector<unsigned>{1});
+	    assert_true(ix.find({skogsek, bergek}) ==
+			(std::vector<unsigned>{0, 1}));
+	    assert_eq(ix.invented().size(), 1);
+	    assert_eq(ix.invented()[0].first, 0);
+	    assert_eq(ix.invented()[0].second, "okand");
+	}
+
+	void only(TC)
+	{
+	    const Book book(text);
+	    Taxa spp = taxa();
+	    assert_eq(read(book, spp, 1, {"skogsek"}),
+		      book.name + ":6: unfamiliar taxon \"okand\"\n" +
+		      book.name + ":9: parse error: garbage\n"
+		      "{\n"
+		      "place : bar\n"
+		      "}{\n"
+		      "skogsek\t\t:#: hej\n"
+		      "\t\t    du\n"
+		      "okand\t\t:#: \n"
+		      "}\n"
+		      "\n");
+	    Cache cache(book.name);
+	    assert_true(Index(cache).valid());
+
+	    for(unsigned jobs : {1, 3}) {
+		Taxa spp2 = taxa();
+		assert_eq(read(book, spp2, jobs, {"bergek"}),
+			  book.name + ":6: unfamiliar taxon \"okand\"\n"
+			  "{\n"
+			  "place : foo\n"
+			  "date  : 2026-05-01\n"
+			  "}{\n"
+			  "bergek\t\t:#: \n"
+			  "okand\t\t:#: hej\n"
+			  "}\n"
+			  "\n");
+		assert_true(spp2.find("okand"));
+
+		Taxa spp3 = taxa();
+		assert_eq(read(book, spp3, jobs, {"skogsek"}),
+			  book.name + ":9: parse error: garbage\n"
+			  "{\n"
+			  "place : bar\n"
+			  "}{\n"
+			  "skogsek\t\t:#: hej\n"
+			  "\t\t    du\n"
+			  "okand\t\t:#: \n"
+			  "}\n"
+			  "\n");
+	    }
+	}
+    }
+}
@@ -0,0 +1,107 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <chunk.h>
+#include <taxa.h>
+
+#include <string>
+#include <sstream>
+
+#include <orchis.h>
+
+namespace {
+
+    Taxa taxa()
+    {
+	std::istringstream iss("bergek  (Quercus petraea)\n"
+			       "skogsek (Quercus robur)\n");
+	std::ostringstream err;
+	return Taxa(iss, err);
+    }
+
+    const char book[] =
+	"{\n"
+	"place: foo\n"
+	"}{\n"
+	"bergek :#:\n"
+	"}\n"
+	"\n"
+	"garbage\n"
+	"{\n"
+	"place: bar\n"
+	"}{\n"
+	"skogsek :#: hej\n"
+	"}\n"
+	"{\n"
+	"place: baz\n";
+
+    /**
+     * Parse 'book' in 'size'-sized Chunks, and return all
+     * excursions and diagnostics in order, as text.
+     */
+    std::string chunked(const size_t size, unsigned& nchunks)
+    {
+	const Files::Segment seg {{"book", 1}, book, book + sizeof book - 1};
+	Files is({seg});
+	Taxa spp = taxa();
+	std::ostringstream oss;
+	Chunk chunk;
+	nchunks = 0;
+	while(chunk.get(is, size)) {
+	    nchunks++;
+	    Parsed parsed;
+	    parsed.parse(chunk, spp);
+	    for(const Parsed::Item& item : parsed.items) {
+		oss << item.err << item.ex.place << '\n';
+	    }
+	    oss << parsed.err;
+	}
+	return oss.str();
+    }
+}
+
+namespace chunk {
+
+    using orchis::TC;
+    using orchis::assert_eq;
+
+    void whole(TC)
+    {
+	unsigned n;
+	assert_eq(chunked(1000, n),
+		  "foo\n"
+		  "book:7: parse error: garbage\n"
+		  "bar\n"
+		  "book:15: trailing partial excursion ignored\n");
+	assert_eq(n, 1);
+    }
+
+    void small(TC)
+    {
+	unsigned n;
+	assert_eq(chunked(1, n),
+		  "foo\n"
+		  "book:7: parse error: garbage\n"
+		  "bar\n"
+		  "book:15: trailing partial excursion ignored\n");
+	assert_eq(n, 4);
+    }
+
+    void unfamiliar(TC)
+    {
+	const char s[] = "{\n}{\nek :#:\n}\n";
+	const Files::Segment seg {{"book", 1}, s, s + sizeof s - 1};
+	Files is({seg});
+	Chunk chunk;
+	orchis::assert_true(chunk.get(is, 1));
+
+	const Taxa spp = taxa();
+	Parsed parsed;
+	try {
+	    parsed.parse(chunk, spp);
+	    orchis::assert_true(false);
+	}
+	catch(const Unfamiliar&) {}
+    }
+}
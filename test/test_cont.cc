@@ -1,7 +1,7 @@
 /*
  * $Id: test_cont.cc,v 1.9 2008-01-03 12:51:39 grahn Exp $
  *
- * Copyright (C) 2006, 2007 Jrgen Grahn.
+ * Copyright (C) 2006, 2007 Jörgen Grahn.
  * All rights reserved.
  */
 #include <iostream>
@@ -0,0 +1,105 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <cooccurrence.h>
+#include <book.h>
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+
+#include <orchis.h>
+
+namespace {
+
+    void add(Book& book, const std::vector<unsigned>& taxa)
+    {
+	FieldList ex;
+	for(unsigned sp : taxa) {
+	    ex.add_sighting(TaxonId(sp), "x", 1, "", 0);
+	}
+	ex.finalize();
+	book.add(ex);
+    }
+
+    std::map<unsigned, unsigned> row(const Cooccurrence& co, unsigned sp)
+    {
+	std::vector<unsigned> scratch;
+	std::vector<Cooccurrence::Pair> acc;
+	co.row(TaxonId(sp), scratch, acc);
+	std::map<unsigned, unsigned> m;
+	for(const auto& p : acc) m[p.sp.val] = p.n;
+	return m;
+    }
+}
+
+namespace cooccurrence {
+
+    using orchis::TC;
+
+    void empty(TC)
+    {
+	const Book book;
+	const Cooccurrence co(book, 10);
+	orchis::assert_eq(co.size(), 0);
+	orchis::assert_eq(co.count(TaxonId(3)), 0);
+	orchis::assert_true(row(co, 3).empty());
+    }
+
+    void simple(TC)
+    {
+	Book book;
+	add(book, {1, 2, 3});
+	add(book, {2, 3});
+	add(book, {3, 3, 4});
+	const Cooccurrence co(book, 10);
+	orchis::assert_eq(co.size(), 3);
+	orchis::assert_eq(co.count(TaxonId(3)), 3);
+
+	std::vector<unsigned> scratch;
+	std::vector<Cooccurrence::Pair> acc;
+	co.row(TaxonId(3), scratch, acc);
+	orchis::assert_eq(acc.size(), 3);
+	orchis::assert_eq(acc[0].sp.val, 2);
+	orchis::assert_eq(acc[0].n, 2);
+	orchis::assert_eq(acc[1].sp.val, 1);
+	orchis::assert_eq(acc[2].sp.val, 4);
+	orchis::assert_eq(acc[2].n, 1);
+	for(unsigned n : scratch) orchis::assert_eq(n, 0);
+
+	orchis::assert_eq(row(co, 4).size(), 1);
+	orchis::assert_true(row(co, 5).empty());
+    }
+
+    /**
+     * Common and rare taxa mixed, against counting every pair.
+     */
+    void mixed(TC)
+    {
+	std::srand(4711);
+	const unsigned taxa = 60;
+	std::vector<std::vector<unsigned>> v;
+	Book book;
+	for(unsigned i = 0; i < 300; i++) {
+	    std::vector<unsigned> ex;
+	    for(unsigned sp = 1; sp < taxa; sp++) {
+		const unsigned odds = sp < 10 ? 2 : 40 + sp;
+		if(std::rand() % odds == 0) ex.push_back(sp);
+	    }
+	    add(book, ex);
+	    v.push_back(ex);
+	}
+	const Cooccurrence co(book, taxa);
+
+	for(unsigned a = 1; a < taxa; a++) {
+	    std::map<unsigned, unsigned> m;
+	    for(const auto& ex : v) {
+		if(std::find(ex.begin(), ex.end(), a)==ex.end()) continue;
+		for(unsigned b : ex) if(b!=a) m[b]++;
+	    }
+	    orchis::assert_true(row(co, a)==m);
+	}
+    }
+}
@@ -1,4 +1,4 @@
-/* Copyright (c) 2014 Jrgen Grahn
+/* Copyright (c) 2014 Jörgen Grahn
  * All rights reserved.
  */
 #include <orchis.h>
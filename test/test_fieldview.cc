@@ -0,0 +1,189 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <fieldview.h>
+#include <files...h>
+#include <taxa.h>
+
+#include <string>
+#include <sstream>
+#include <cstring>
+
+#include <orchis.h>
+
+namespace {
+
+    Taxa taxa()
+    {
+	std::istringstream iss("bergek  (Quercus petraea)\n"
+			       "skogsek (Quercus robur)\n");
+	std::ostringstream err;
+	return Taxa(iss, err);
+    }
+
+    const char book[] =
+	"{\n"
+	"place : foo\n"
+	"  # not part of it\n"
+	"        bar  \n"
+	"\n"
+	"        baz\n"
+	"date  : 2020-05-17\n"
+	"}{\n"
+	"bergek  :#: one\n"
+	"             two\n"
+	"skogsek :#:\n"
+	"}\n";
+
+    /**
+     * The first excursion in 'book', parsed as a T.  Its
+     * diagnostics go to 'err'.
+     */
+    template<class T>
+    bool parse(T& ex, std::ostream& err, const char* book = ::book)
+    {
+	const Files::Segment seg {{"book", 1}, book, book + std::strlen(book)};
+	Files is({seg});
+	Taxa spp = taxa();
+	return get(is, err, spp, ex);
+    }
+}
+
+namespace fieldview {
+
+    using orchis::TC;
+
+    void text(TC)
+    {
+	const char s[] = "foo bar";
+	const FieldView::Text t(s, 3);
+	orchis::assert_true(t.simple());
+	orchis::assert_eq(t.str(), "foo");
+	orchis::assert_true(t=="foo");
+	orchis::assert_true(t!="foo bar");
+	orchis::assert_true(FieldView::Text().empty());
+    }
+
+    void continuation(TC)
+    {
+	FieldView ex;
+	std::ostringstream err;
+	orchis::assert_true(parse(ex, err));
+	orchis::assert_eq(err.str(), "");
+
+	const FieldView::Text& place = ex.find_header("place");
+	orchis::assert_false(place.simple());
+	orchis::assert_eq(place.str(), "foo\nbar\nbaz");
+	orchis::assert_true(place=="foo\nbar\nbaz");
+	orchis::assert_eq(ex.place.str(), "foo\nbar\nbaz");
+
+	auto i = ex.sbegin();
+	orchis::assert_eq(i->comment.str(), "one\ntwo");
+	i++;
+	orchis::assert_true(i->comment.empty());
+    }
+
+    void skipped(TC)
+    {
+	const char book[] =
+	    "{\n"
+	    "place : foo\n"
+	    "broken\n"
+	    "        bar\n"
+	    "date  : 2020-05-17\n"
+	    "}{\n"
+	    "bergek  :#: one\n"
+	    "skogsek : :\n"
+	    "             two\n"
+	    "garbage\n"
+	    "             three\n"
+	    "}\n";
+	FieldView view;
+	Excursion ex;
+	std::ostringstream err1;
+	std::ostringstream err2;
+	orchis::assert_true(parse(view, err1, book));
+	orchis::assert_true(parse(ex, err2, book));
+	orchis::assert_eq(err1.str(), err2.str());
+
+	orchis::assert_eq(view.place.str(), "foo\nbar");
+	orchis::assert_eq(view.sbegin()->comment.str(), "one\ntwo\nthree");
+
+	std::ostringstream a;
+	std::ostringstream b;
+	a << view;
+	b << ex;
+	orchis::assert_eq(a.str(), b.str());
+    }
+
+    void same(TC)
+    {
+	FieldView view;
+	Excursion ex;
+	std::ostringstream err1;
+	std::ostringstream err2;
+	orchis::assert_true(parse(view, err1));
+	orchis::assert_true(parse(ex, err2));
+	orchis::assert_eq(err1.str(), err2.str());
+
+	std::ostringstream a;
+	std::ostringstream b;
+	a << view;
+	b << ex;
+	orchis::assert_eq(a.str(), b.str());
+	orchis::assert_eq(view.date.value(), ex.date.value());
+    }
+
+    void assign(TC)
+    {
+	Excursion ex;
+	std::ostringstream err;
+	orchis::assert_true(parse(ex, err));
+
+	FieldView view;
+	view.assign(ex);
+	orchis::assert_true(view.find_header("place").simple());
+	orchis::assert_eq(view.find_header("place").str(), "foo\nbar\nbaz");
+
+	Excursion ex2;
+	view.copy(ex2);
+	std::ostringstream a;
+	std::ostringstream b;
+	a << ex;
+	b << ex2;
+	orchis::assert_eq(a.str(), b.str());
+    }
+
+    void known(TC)
+    {
+	orchis::assert_eq(header::known("observers", 9), header::OBSERVERS);
+	orchis::assert_eq(header::known("observer", 8), header::OTHER);
+	orchis::assert_eq(header::known("places", 6), header::OTHER);
+	orchis::assert_eq(header::known("", 0), header::OTHER);
+	orchis::assert_eq(header::known("coordinates", 11), header::OTHER);
+
+	const char s[] = "status: 1\n"
+			 "coordinate: 6540 1260\n"
+			 "status: 2\n";
+	FieldView view;
+	Excursion ex;
+	orchis::assert_true(view.add_header("status", 6, s + 8, 1));
+	orchis::assert_true(ex.add_header("status", 6, s + 8, 1));
+	view.add_header("coordinate", 10, s + 22, 9);
+	ex.add_header("coordinate", 10, s + 22, 9);
+	orchis::assert_false(view.add_header("status", 6, s + 40, 1));
+	orchis::assert_false(ex.add_header("status", 6, s + 40, 1));
+	view.finalize();
+	ex.finalize();
+
+	orchis::assert_eq(view.header(header::STATUS).str(), "1");
+	orchis::assert_eq(ex.header(header::STATUS), "1");
+	orchis::assert_eq(view.find_header("status").str(), "1");
+	orchis::assert_true(view.has_header("coordinate"));
+	orchis::assert_false(ex.has_header("place"));
+	orchis::assert_true(view.coordinate.valid());
+	orchis::assert_eq(ex.coordinate.north, 6540000);
+	orchis::assert_eq(ex.coordinate.east, 1260000);
+    }
+}
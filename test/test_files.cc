@@ -0,0 +1,252 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <files...h>
+
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <orchis.h>
+
+namespace {
+
+    /**
+     * A temporary file with a given content, removed at the
+     * end of the test.
+     */
+    struct Tmp {
+	explicit Tmp(const std::string& s)
+	{
+	    char buf[] = "/tmp/groblad.test.XXXXXX";
+	    const int fd = mkstemp(buf);
+	    if(fd!=-1) close(fd);
+	    name = buf;
+	    std::ofstream os(name);
+	    os << s;
+	}
+	~Tmp() { std::remove(name.c_str()); }
+	std::string name;
+    };
+
+    /**
+     * A pipe fed with a given content by a thread, so that Files
+     * has to read(2) it rather than map it.  Named through /dev/fd,
+     * or taken as standard input while it lives.
+     */
+    struct Pipe {
+	explicit Pipe(const std::string& s, bool as_stdin = false)
+	    : saved(-1)
+	{
+	    int fd[2];
+	    if(pipe(fd)) return;
+	    rfd = fd[0];
+	    if(as_stdin) {
+		saved = dup(0);
+		dup2(rfd, 0);
+	    }
+	    name = "/dev/fd/" + std::to_string(rfd);
+	    const int wfd = fd[1];
+	    writer = std::thread([s, wfd] {
+		    const char* p = s.data();
+		    const char* const e = p + s.size();
+		    while(p!=e) {
+			/* small writes, to make Files refill a lot */
+			const size_t n = std::min<size_t>(e - p, 10000);
+			const ssize_t rc = write(wfd, p, n);
+			if(rc<=0) break;
+			p += rc;
+		    }
+		    close(wfd);
+		});
+	}
+	~Pipe()
+	{
+	    writer.join();
+	    close(rfd);
+	    if(saved!=-1) {
+		dup2(saved, 0);
+		close(saved);
+	    }
+	}
+	int rfd;
+	int saved;
+	std::string name;
+	std::thread writer;
+    };
+
+    void assert_line(Files& ff, const char* s,
+		     const std::string& file, unsigned line)
+    {
+	const char* a;
+	const char* b;
+	orchis::assert_true(ff.getline(a, b));
+	orchis::assert_eq(std::string(a, b), s);
+	orchis::assert_eq(ff.position().file, file);
+	orchis::assert_eq(ff.position().line, line);
+    }
+
+    void assert_eof(Files& ff)
+    {
+	std::string s;
+	orchis::assert_false(ff.getline(s));
+	orchis::assert_false(ff.getline(s));
+    }
+}
+
+namespace files {
+
+    using orchis::TC;
+
+    void empty(TC)
+    {
+	const Tmp f("");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_eof(ff);
+    }
+
+    void simple(TC)
+    {
+	const Tmp f("foo\n"
+		    "\n"
+		    "bar\n");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, "", f.name, 2);
+	assert_line(ff, "bar", f.name, 3);
+	assert_eof(ff);
+    }
+
+    void no_newline(TC)
+    {
+	const Tmp f("foo\n"
+		    "bar");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, "bar", f.name, 2);
+	assert_eof(ff);
+    }
+
+    void several(TC)
+    {
+	const Tmp f("foo\n"
+		    "bar");
+	const Tmp g("");
+	const Tmp h("baz\n");
+	const std::vector<std::string> v{f.name, g.name, h.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, "bar", f.name, 2);
+	assert_line(ff, "baz", h.name, 1);
+	assert_eof(ff);
+    }
+
+    void nothing(TC)
+    {
+	const std::vector<std::string> v;
+	Files ff(begin(v), end(v), false);
+	assert_eof(ff);
+    }
+
+    void boundaries(TC)
+    {
+	const Tmp f("foo\n"
+		    "\n"
+		    "# comment\n");
+	const Tmp g("bar\n");
+	const Tmp h("baz\n");
+	const std::vector<std::string> v{f.name, g.name, h.name};
+	Files ff(begin(v), end(v));
+	orchis::assert_true(ff.exhausted());
+	orchis::assert_eq(*ff.upcoming(), f.name);
+	assert_line(ff, "foo", f.name, 1);
+	orchis::assert_true(ff.exhausted());
+	orchis::assert_eq(*ff.upcoming(), g.name);
+	ff.skip();
+	orchis::assert_true(ff.exhausted());
+	orchis::assert_eq(*ff.upcoming(), h.name);
+	assert_line(ff, "baz", h.name, 1);
+	orchis::assert_true(ff.exhausted());
+	orchis::assert_false(ff.upcoming());
+	assert_eof(ff);
+    }
+
+    void not_exhausted(TC)
+    {
+	const Tmp f("foo\n"
+		    "\n"
+		    "bar\n");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	orchis::assert_false(ff.exhausted());
+	assert_line(ff, "bar", f.name, 3);
+	orchis::assert_true(ff.exhausted());
+	assert_eof(ff);
+    }
+
+    void pipe(TC)
+    {
+	const Pipe f("foo\n"
+		     "\n"
+		     "bar");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, "", f.name, 2);
+	orchis::assert_eq(ff.offset(), 5);
+	assert_line(ff, "bar", f.name, 3);
+	assert_eof(ff);
+    }
+
+    void standard_input(TC)
+    {
+	const Pipe f("foo\n"
+		     "bar\n", true);
+	const Tmp g("baz\n");
+	const std::vector<std::string> v{"-", g.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", "<stdin>", 1);
+	assert_line(ff, "bar", "<stdin>", 2);
+	assert_line(ff, "baz", g.name, 1);
+	assert_eof(ff);
+    }
+
+    void long_line(TC)
+    {
+	/* longer than the 256 KiB read buffer, several times over */
+	const std::string s(1 << 20, 'x');
+	const Pipe f("foo\n" + s + "\n"
+		     "bar\n" + s);
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, s.c_str(), f.name, 2);
+	assert_line(ff, "bar", f.name, 3);
+	orchis::assert_eq(ff.offset(), 4 + s.size() + 1 + 4);
+	assert_line(ff, s.c_str(), f.name, 4);
+	assert_eof(ff);
+    }
+
+    void long_line_mapped(TC)
+    {
+	const std::string s(1 << 20, 'x');
+	const Tmp f("foo\n" + s + "\n"
+		    "bar\n");
+	const std::vector<std::string> v{f.name};
+	Files ff(begin(v), end(v));
+	assert_line(ff, "foo", f.name, 1);
+	assert_line(ff, s.c_str(), f.name, 2);
+	assert_line(ff, "bar", f.name, 3);
+	assert_eof(ff);
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2013 Jrgen Grahn.
+ * Copyright (C) 2013 Jörgen Grahn.
  * All rights reserved.
  */
 #include <filetest.h>
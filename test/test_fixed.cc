@@ -0,0 +1,118 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <fixed.h>
+#include <regex.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <orchis.h>
+
+namespace fixed {
+
+    using orchis::TC;
+
+    void simple(TC)
+    {
+	orchis::assert_true(Fixed("").match(""));
+	orchis::assert_true(Fixed("").match("foo"));
+	orchis::assert_true(Fixed("foo").match("foo"));
+	orchis::assert_true(Fixed("foo").match("a foo b"));
+	orchis::assert_true(Fixed("foo").match("a fo foo"));
+	orchis::assert_false(Fixed("foo").match("fo"));
+	orchis::assert_false(Fixed("foo").match("a fo fob"));
+	orchis::assert_false(Fixed("a.c").match("abc"));
+	orchis::assert_true(Fixed("a.c").match("a.c"));
+    }
+
+    void ascii(TC)
+    {
+	orchis::assert_true(Fixed("foo").match("FOO"));
+	orchis::assert_true(Fixed("FoO").match("xfOo"));
+	orchis::assert_true(Fixed("JoG").match("jog"));
+	orchis::assert_false(Fixed("@").match("`"));
+	orchis::assert_false(Fixed("[").match("{"));
+    }
+
+    void latin1(TC)
+    {
+	orchis::assert_true(Fixed("\xe5sa").match("\xc5SA"));
+	orchis::assert_true(Fixed("\xc4ngen").match("p\xe4ngen"));
+	orchis::assert_true(Fixed("k\xf6rsb\xe4r").match("K\xd6RSB\xc4R"));
+	orchis::assert_false(Fixed("\xe5").match("a"));
+	orchis::assert_false(Fixed("\xd7").match("\xf7"));
+    }
+
+    void utf8(TC)
+    {
+	orchis::assert_true(Fixed("\xc3\xa5sa").match("\xc3\x85SA"));
+	orchis::assert_true(Fixed("\xc3\x84ngen").match("p\xc3\xa4ngen"));
+	orchis::assert_true(Fixed("k\xc3\xb6rsb\xc3\xa4r")
+			    .match("K\xc3\x96RSB\xc3\x84R"));
+	orchis::assert_false(Fixed("\xc3\xa5").match("\xc3\xa4"));
+	orchis::assert_false(Fixed("\xc3\x97").match("\xc3\xb7"));
+	orchis::assert_false(Fixed("\xc3\xa5").match("\xe3\xa5"));
+    }
+
+    /**
+     * Long enough to go through the vectorized search, with the
+     * match at every possible place.
+     */
+    void long_text(TC)
+    {
+	const Fixed f("Kr\xc3\xa5kvicker");
+	const std::string needle = "KR\xc3\x85KVICKER";
+	for(unsigned i = 0; i < 80; i++) {
+	    std::string s(i, 'k');
+	    s += needle;
+	    s += std::string(80 - i, 'r');
+	    orchis::assert_true(f.match(s));
+	    s[i + 5] = 'x';
+	    orchis::assert_false(f.match(s));
+	}
+	const std::string s(200, 'r');
+	orchis::assert_false(f.match(s));
+	orchis::assert_true(Fixed("r").match(s));
+	orchis::assert_false(Fixed("r").match(std::string(200, 'x')));
+    }
+
+    /**
+     * The same answers as Regex, in ASCII.
+     */
+    void regex(TC)
+    {
+	const char* const texts[] = { "", "foo", "Foo Bar", "FOOBAR", "xfoob" };
+	for(const char* pat : { "foo", "bar", "ob", "x" }) {
+	    const Fixed f(pat);
+	    const Regex re(pat);
+	    for(const char* s : texts) {
+		orchis::assert_eq(f.match(s), re.match(s));
+	    }
+	}
+    }
+
+    void literals(TC)
+    {
+	const Literals lit({"foo", "", "BAR", "ob", "xyzzy"});
+	std::vector<bool> found(5);
+	const std::string s = "Foo bAr";
+	lit.find(s.data(), s.data() + s.size(), found);
+	orchis::assert_true(found[0]);
+	orchis::assert_true(found[1]);
+	orchis::assert_true(found[2]);
+	orchis::assert_false(found[3]);
+	orchis::assert_false(found[4]);
+
+	/* not across texts, and not past the end */
+	const std::string t = "foo ba";
+	std::fill(found.begin(), found.end(), false);
+	lit.find(t.data(), t.data() + 5, found);
+	lit.find(t.data() + 5, t.data() + t.size(), found);
+	orchis::assert_true(found[0]);
+	orchis::assert_false(found[2]);
+	orchis::assert_false(found[3]);
+    }
+}
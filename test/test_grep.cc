@@ -0,0 +1,184 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <grep.h>
+#include <files...h>
+#include <taxa.h>
+#include <regex.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include <orchis.h>
+
+#include "book_fixture.h"
+
+namespace {
+
+    using fixture::taxa;
+
+    const char text[] =
+	"{\n"
+	"place: Lund\n"
+	"date: 2026-05-01\n"
+	"}{\n"
+	"bergek :#: vid ån\n"
+	"}\n"
+	"{\n"
+	"place: Malmö\n"
+	"}{\n"
+	"skogsek :#:\n"
+	"}\n"
+	"{\n"
+	"place: Ystad\n"
+	"}{\n"
+	"bergek :#: som i Lund\n"
+	"}\n";
+
+    /**
+     * Run grep::grep() over a book with 'text' and patterns 'pv', and
+     * return the places of the excursions which end up in each
+     * output, like "Lund,Ystad|Malmö".
+     */
+    std::string run(const std::vector<grep::Pattern>& pv,
+		    bool taxa_only = false,
+		    bool invert = false)
+    {
+	std::vector<std::unique_ptr<Regex>> re;
+	std::vector<std::string> names;
+	std::vector<size_t> dest;
+	for(const auto& p : pv) {
+	    re.emplace_back(new Regex(p.second));
+	    const auto i = std::find(names.begin(), names.end(), p.first);
+	    dest.push_back(i - names.begin());
+	    if(i==names.end()) names.push_back(p.first);
+	}
+
+	std::vector<std::ostringstream> oss(names.size());
+	std::vector<grep::Output> out;
+	for(auto& os : oss) out.emplace_back(os);
+
+	const fixture::Book book(text);
+	const std::vector<std::string> v{book.name};
+	Files files(begin(v), end(v));
+	Taxa spp = taxa();
+	grep::grep(re, dest, out, files, spp, 1, taxa_only, invert);
+
+	std::string acc;
+	for(auto& os : oss) {
+	    if(&os != &oss.front()) acc.push_back('|');
+	    std::istringstream is(os.str());
+	    std::string s;
+	    std::string places;
+	    while(std::getline(is, s)) {
+		if(s.compare(0, 8, "place : ")) continue;
+		if(!places.empty()) places.push_back(',');
+		places += s.substr(8);
+	    }
+	    acc += places;
+	}
+	return acc;
+    }
+}
+
+namespace grep {
+
+    using orchis::TC;
+    using orchis::assert_eq;
+    using orchis::assert_true;
+    using orchis::assert_false;
+
+    void pattern_file(TC)
+    {
+	std::istringstream is("# comment\n"
+			      "\n"
+			      "-\tfoo\n"
+			      "out  bar  baz\n"
+			      "  \t \n"
+			      "  # indented comment\n"
+			      "\tx \t b.*r\n");
+	std::ostringstream err;
+	std::vector<Pattern> acc;
+	assert_true(patterns(acc, is, "f", err));
+	assert_eq(err.str(), "");
+	assert_eq(acc.size(), 3);
+	assert_eq(acc[0].first, "-");
+	assert_eq(acc[0].second, "foo");
+	assert_eq(acc[1].first, "out");
+	assert_eq(acc[1].second, "bar  baz");
+	assert_eq(acc[2].first, "x");
+	assert_eq(acc[2].second, "b.*r");
+    }
+
+    void missing_pattern(TC)
+    {
+	for(const char* s : {"-\tfoo\n"
+			     "out\n",
+			     "-\tfoo\n"
+			     "out \t\n"}) {
+	    std::istringstream is(s);
+	    std::ostringstream err;
+	    std::vector<Pattern> acc;
+	    assert_false(patterns(acc, is, "f", err));
+	    assert_eq(err.str(), "f:2: missing pattern\n");
+	}
+    }
+
+    void routing(TC)
+    {
+	/* both patterns match Lund and Ystad */
+	assert_eq(run({{"a", "Lund"}, {"a", "bergek"}, {"b", "Ystad"}}),
+		  "Lund,Ystad|Ystad");
+	assert_eq(run({{"a", "Lund"}, {"b", "Lund"}}),
+		  "Lund,Ystad|Lund,Ystad");
+	assert_eq(run({{"a", "nowhere"}, {"b", "Malm"}}),
+		  "|Malmö");
+    }
+
+    void taxa_only(TC)
+    {
+	assert_eq(run({{"a", "bergek"}, {"b", "skog"}, {"c", "Lund"}}, true),
+		  "Lund,Ystad|Malmö|");
+	assert_eq(run({{"a", "bergek"}, {"a", "skog"}}, true),
+		  "Lund,Malmö,Ystad");
+    }
+
+    void inverted(TC)
+    {
+	assert_eq(run({{"a", "Lund"}, {"b", "Malm"}}, false, true),
+		  "Malmö|Lund,Ystad");
+	/* an excursion goes to 'a' if either pattern doesn't match */
+	assert_eq(run({{"a", "Lund"}, {"a", "Malm"}}, false, true),
+		  "Lund,Malmö,Ystad");
+	assert_eq(run({{"a", "bergek"}, {"b", "skog"}}, true, true),
+		  "Malmö|Lund,Ystad");
+    }
+
+    /**
+     * Looking for the patterns' literals together first doesn't
+     * change which excursions they match.
+     */
+    void prefilter(TC)
+    {
+	const std::vector<Pattern> pv = {{"0", "LUND"},
+					 {"1", "^Ly"},
+					 {"2", "ystad|lund"},
+					 {"3", "zz+"},
+					 {"4", "[bB]ergek"},
+					 {"5", "som i"},
+					 {"6", "i Lund$"},
+					 {"7", "Lund.*Ystad"},
+					 {"8", "vid ån"}};
+	std::string alone;
+	for(const Pattern& p : pv) {
+	    if(&p != &pv.front()) alone.push_back('|');
+	    alone += run({p});
+	}
+	assert_eq(alone, "Lund,Ystad||Lund,Ystad||Lund,Ystad|"
+		  "Ystad|Ystad||Lund");
+	assert_eq(run(pv), alone);
+    }
+}
@@ -1,4 +1,4 @@
-/* Copyright (C) 2013 Jrgen Grahn.
+/* Copyright (C) 2013 Jörgen Grahn.
  * All rights reserved.
  */
 #include <indent.h>
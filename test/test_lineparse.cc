@@ -0,0 +1,84 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <lineparse.h>
+
+#include <string>
+
+#include <orchis.h>
+
+namespace {
+
+    /**
+     * All strings of length 'n' with a single non-whitespace octet
+     * 'ch' somewhere in a background of 'bg', or none at all.  Calls
+     * f(s, i) where i is the position of 'ch', or n.
+     */
+    template<class F>
+    void each(const size_t n, const char bg, const char ch, F f)
+    {
+	for(size_t i=0; i<=n; i++) {
+	    std::string s(n, bg);
+	    if(i<n) s[i] = ch;
+	    f(s, i);
+	}
+    }
+}
+
+namespace lineparse {
+
+    using orchis::TC;
+    using orchis::assert_eq;
+    using Parse::ws;
+    using Parse::non_ws;
+    using Parse::trimr;
+
+    void left(TC)
+    {
+	for(size_t n=0; n<100; n++) {
+	    for(char bg : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+		each(n, bg, 'x', [] (const std::string& s, size_t i) {
+				     const char* a = s.data();
+				     assert_eq(size_t(ws(a, a + s.size()) - a), i);
+				 });
+	    }
+	}
+    }
+
+    void right(TC)
+    {
+	for(size_t n=0; n<100; n++) {
+	    for(char bg : {' ', '\t', '\r'}) {
+		each(n, bg, '\xe5', [n] (const std::string& s, size_t i) {
+					const char* a = s.data();
+					const size_t j = i<n ? i+1 : 0;
+					assert_eq(size_t(trimr(a, a + s.size()) - a), j);
+				    });
+	    }
+	}
+    }
+
+    void non_space(TC)
+    {
+	for(size_t n=0; n<100; n++) {
+	    for(char bg : {'x', '\x80', '\xff', '\x08', '\x0e', '\x1f', '!'}) {
+		each(n, bg, ' ', [] (const std::string& s, size_t i) {
+				     const char* a = s.data();
+				     assert_eq(size_t(non_ws(a, a + s.size()) - a), i);
+				 });
+	    }
+	}
+    }
+
+    void find(TC)
+    {
+	const std::string s = "foo : bar : baz";
+	const char* a = s.data();
+	const char* b = a + s.size();
+	assert_eq(Parse::find(a, b, ':') - a, 4);
+	assert_eq(Parse::find(a+5, b, ':') - a, 10);
+	assert_eq(Parse::find(a+11, b, ':') - a, 15);
+	assert_eq(Parse::find(a, a, ':') - a, 0);
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Jrgen Grahn.
+ * Copyright (C) 2018 Jörgen Grahn.
  * All rights reserved.
  */
 #include <names.h>
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <regex.h>
+
+#include <orchis.h>
+
+namespace regex {
+
+    using orchis::TC;
+
+    void assert_match(const char* re, const char* s)
+    {
+	const Regex r(re);
+	orchis::assert_false(r.bad());
+	orchis::assert_true(r.match(s));
+    }
+
+    void assert_no_match(const char* re, const char* s)
+    {
+	const Regex r(re);
+	orchis::assert_false(r.bad());
+	orchis::assert_false(r.match(s));
+    }
+
+    void simple(TC)
+    {
+	assert_match("foo", "foo");
+	assert_match("foo", "a FOO b");
+	assert_no_match("foo", "fo");
+	assert_match("k\xe4rr.*lund", "K\xe4rrlunda");
+	assert_match("k\xe4rr.*lund", "k\xe4rr och lund");
+	assert_no_match("k\xe4rr.*lund", "k\xe4rr");
+	assert_no_match("k\xe4rr.*lund", "lund");
+	assert_match("^foo$", "foo");
+	assert_no_match("^foo$", "foo ");
+	assert_match("", "");
+	assert_match("", "foo");
+    }
+
+    void quantified(TC)
+    {
+	assert_match("ab*c", "ac");
+	assert_match("ab*c", "abbc");
+	assert_match("ab?c", "ac");
+	assert_match("ab{0,2}c", "ac");
+	assert_match("ab+c", "abbbc");
+	assert_no_match("ab+c", "ac");
+	assert_match("x{2}", "xx");
+	assert_match("(foo)?bar", "bar");
+	assert_match("(foo)*bar", "bar");
+	assert_match("a(b|c)d", "acd");
+	assert_match("foo|bar", "bar");
+	assert_match(".*", "");
+	assert_match("ab+?c", "ac");
+	assert_match("ab+*c", "ac");
+	assert_match("ab+{0}c", "ac");
+	assert_match("ab++c", "abc");
+	assert_match("xa+*", "x");
+	assert_no_match("ab+?c", "abd");
+    }
+
+    void escaped(TC)
+    {
+	assert_match("a\\.b", "a.b");
+	assert_no_match("a\\.b", "axb");
+	assert_match("a.b", "axb");
+	assert_match("a\\*", "a*");
+	assert_match("\\(x\\)", "(x)");
+	assert_match("\\<foo\\>", "a foo b");
+	assert_match("(a)\\1", "aa");
+    }
+
+    void bracket(TC)
+    {
+	assert_match("[ab]c", "bc");
+	assert_match("[^x]c", "bc");
+	assert_match("[]x]y", "]y");
+	assert_match("[]x]y", "xy");
+	assert_match("[[:digit:]]+ m", "12 m");
+	assert_match("[[:alpha:]]]", "a]");
+	assert_no_match("[[:digit:]]+ m", "12m");
+    }
+
+    void range(TC)
+    {
+	const char s[] = "xfoo bar\0baz";
+	const Regex foo("^foo");
+	orchis::assert_false(foo.match(s, s+4));
+	orchis::assert_true(foo.match(s+1, s+4));
+	orchis::assert_false(foo.match(s+1, s+3));
+	const Regex bar("bar$");
+	orchis::assert_true(bar.match(s, s+8));
+	orchis::assert_false(bar.match(s, s+7));
+	const Regex baz("baz");
+	orchis::assert_false(baz.match(s));
+	orchis::assert_true(baz.match(s, s + sizeof s - 1));
+	const Regex empty("^$");
+	orchis::assert_true(empty.match(s, s));
+    }
+}
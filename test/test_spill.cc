@@ -0,0 +1,101 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <spill.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include <orchis.h>
+
+namespace {
+
+    typedef std::vector<Spill::Pair> Pairs;
+
+    /**
+     * Some pairs, with plenty of duplicate keys.
+     */
+    Pairs pairs(const size_t n)
+    {
+	Pairs v;
+	std::srand(4711);
+	for(size_t i=0; i<n; i++) {
+	    v.push_back({unsigned(std::rand() % 100), uint64_t(std::rand())});
+	}
+	return v;
+    }
+
+    Pairs sorted(const Pairs& v, const size_t budget, size_t& runs)
+    {
+	Spill spill(budget);
+	for(const Spill::Pair& p : v) spill.add(p.key, p.val);
+	runs = spill.runs();
+	Pairs acc;
+	unsigned key;
+	uint64_t val;
+	while(spill.get(key, val)) acc.push_back({key, val});
+	return acc;
+    }
+
+    bool same(const Pairs& a, const Pairs& b)
+    {
+	auto eq = [] (const Spill::Pair& a, const Spill::Pair& b) {
+		      return a.key==b.key && a.val==b.val;
+		  };
+	return a.size()==b.size() && std::equal(a.begin(), a.end(), b.begin(), eq);
+    }
+}
+
+namespace spill {
+
+    using orchis::TC;
+
+    void empty(TC)
+    {
+	size_t runs;
+	orchis::assert_true(sorted({}, 0, runs).empty());
+	orchis::assert_eq(runs, 0);
+    }
+
+    void in_memory(TC)
+    {
+	Pairs v = pairs(1000);
+	size_t runs;
+	const Pairs w = sorted(v, 1 << 20, runs);
+	std::sort(v.begin(), v.end());
+	orchis::assert_true(same(w, v));
+	orchis::assert_eq(runs, 0);
+    }
+
+    void runs(TC)
+    {
+	Pairs v = pairs(5000);
+	size_t runs;
+	const Pairs w = sorted(v, 0, runs);
+	std::sort(v.begin(), v.end());
+	orchis::assert_true(same(w, v));
+	orchis::assert_eq(runs, 4);
+    }
+
+    void exact(TC)
+    {
+	Pairs v = pairs(2048);
+	size_t runs;
+	const Pairs w = sorted(v, 0, runs);
+	std::sort(v.begin(), v.end());
+	orchis::assert_true(same(w, v));
+	orchis::assert_eq(runs, 1);
+    }
+
+    void many_runs(TC)
+    {
+	Pairs v = pairs(200 * 1024 + 17);
+	size_t runs;
+	const Pairs w = sorted(v, 0, runs);
+	std::sort(v.begin(), v.end());
+	orchis::assert_true(same(w, v));
+	orchis::assert_eq(runs, 200);
+    }
+}
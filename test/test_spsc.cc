@@ -0,0 +1,79 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <spsc.h>
+
+#include <memory>
+#include <thread>
+#include <chrono>
+
+#include <orchis.h>
+
+namespace spsc {
+
+    using orchis::TC;
+
+    void order(TC)
+    {
+	Spsc<unsigned> q(3);
+	std::thread producer([&q] {
+		for(unsigned i=0; i<100000; i++) q.push(i);
+	    });
+	for(unsigned i=0; i<100000; i++) {
+	    orchis::assert_eq(q.pop(), i);
+	}
+	producer.join();
+    }
+
+    void full(TC)
+    {
+	Spsc<unsigned> q(2);
+	q.push(1);
+	q.push(2);
+
+	std::atomic<bool> done(false);
+	std::thread producer([&q, &done] {
+		q.push(3);
+		done = true;
+	    });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	orchis::assert_false(done);
+
+	orchis::assert_eq(q.pop(), 1);
+	producer.join();
+	orchis::assert_true(done);
+	orchis::assert_eq(q.pop(), 2);
+	orchis::assert_eq(q.pop(), 3);
+    }
+
+    void empty(TC)
+    {
+	Spsc<unsigned> q(2);
+	std::thread producer([&q] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		q.push(4711);
+	    });
+	orchis::assert_eq(q.pop(), 4711);
+	producer.join();
+    }
+
+    void end_of_stream(TC)
+    {
+	/* like Pipeline: null marks the end */
+	Spsc<std::unique_ptr<unsigned>> q(4);
+	std::thread producer([&q] {
+		for(unsigned i=0; i<1000; i++) {
+		    q.push(std::unique_ptr<unsigned>(new unsigned(i)));
+		}
+		q.push(nullptr);
+	    });
+	unsigned n = 0;
+	while(std::unique_ptr<unsigned> p = q.pop()) {
+	    orchis::assert_eq(*p, n);
+	    n++;
+	}
+	orchis::assert_eq(n, 1000);
+	producer.join();
+    }
+}
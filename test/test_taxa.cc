@@ -1,9 +1,18 @@
 /*
- * Copyright (C) 2014 Jrgen Grahn.
+ * Copyright (C) 2014 Jörgen Grahn.
  * All rights reserved.
  */
 #include <taxa.h>
+#include <vector>
 #include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdlib.h>
+#include <unistd.h>
 
 #include <orchis.h>
 
@@ -31,6 +40,51 @@ namespace {
 	orchis::assert_eq(spp.find(a), spp.find(b));
 	if(c) orchis::assert_eq(spp.find(a), spp.find(c));
     }
+
+    /**
+     * A species file in a temporary directory of its own, removed
+     * (with its snapshot) at the end of the test.
+     */
+    struct File {
+	explicit File(const std::string& s)
+	{
+	    char buf[] = "/tmp/groblad.test.XXXXXX";
+	    dir = mkdtemp(buf) ? buf : "/tmp";
+	    name = dir + "/species";
+	    std::ofstream os(name);
+	    os << s;
+	}
+	~File()
+	{
+	    std::remove(name.c_str());
+	    std::remove((dir + "/.species.snapshot").c_str());
+	    rmdir(dir.c_str());
+	}
+	std::string read(std::string& err) const
+	{
+	    std::ifstream is(name);
+	    std::ostringstream es;
+	    const Taxa spp(name, is, es);
+	    err = es.str();
+	    std::ostringstream os;
+	    spp.put(os);
+	    std::vector<std::string> v = spp.names();
+	    std::sort(begin(v), end(v));
+	    for(const std::string& s : v) os << s << " = " << spp.find(s).val << '\n';
+	    return os.str();
+	}
+	std::string dir;
+	std::string name;
+    };
+
+    const char species[] =
+	"bergek  (Quercus petraea)\n"
+	"skogsek (Quercus robur)\n"
+	"= ek\n"
+	"-             (Cotoneaster)\n"
+	"fetblad       (Phedimus)\n"
+	"= Sedum\n"
+	"ek\n";
 }
 
 
@@ -104,4 +158,144 @@ namespace taxa {
 	assert_same(spp, "fetblad", "Phedimus", "Phedimus sp");
 	assert_same(spp, "fetblad", "Sedum");
     }
+
+    void find_range(TC)
+    {
+	Taxa spp = list("bergek  (Quercus petraea)\n"
+			"skogsek (Quercus robur)\n"
+			"= ek");
+	const char s[] = "ekbergek";
+	orchis::assert_eq(spp.find(s, 2), spp.find("skogsek"));
+	orchis::assert_eq(spp.find(s + 2, 6), spp.find("bergek"));
+	orchis::assert_(!spp.find(s, 3));
+	orchis::assert_(!spp.find(s, 0));
+
+	for(unsigned i=0; i<1000; i++) {
+	    spp.insert("okand" + std::to_string(i));
+	}
+	orchis::assert_eq(spp.find(s, 2), spp.find("skogsek"));
+	orchis::assert_eq(spp.find("okand999").val, 3 + 1000);
+	orchis::assert_eq(spp.names().size(), 7 + 1000);
+    }
+
+    void snapshot(TC)
+    {
+	const File file(species);
+	std::string err;
+	const std::string s = file.read(err);
+	orchis::assert_eq(err, "warning: \"ek\" has already been used "
+			  "to name a different taxon\n");
+	std::ifstream is(file.dir + "/.species.snapshot");
+	orchis::assert_(is);
+
+	std::string err2;
+	orchis::assert_eq(file.read(err2), s);
+	orchis::assert_eq(err2, err);
+
+	std::istringstream iss(species);
+	std::ostringstream es;
+	Taxa spp(file.name, iss, es);
+	orchis::assert_(!spp.find("okand"));
+	const TaxonId id = spp.insert("okand");
+	orchis::assert_eq(spp.find("okand"), id);
+	orchis::assert_eq(spp.find("ek"), spp.find("skogsek"));
+	orchis::assert_eq(spp.insert("ek"), TaxonId());
+    }
+
+    void snapshot_stale(TC)
+    {
+	const File file(species);
+	std::string err;
+	file.read(err);
+	{
+	    std::ofstream os(file.name, std::ios_base::app);
+	    os << "ask (Fraxinus excelsior)\n";
+	}
+	const std::string s = file.read(err);
+	orchis::assert_(s.find("ask = ") != std::string::npos);
+	orchis::assert_eq(file.read(err), s);
+    }
+
+    std::string snapshot_of(const File& file)
+    {
+	std::ifstream is(file.dir + "/.species.snapshot");
+	return std::string((std::istreambuf_iterator<char>(is)),
+			   std::istreambuf_iterator<char>());
+    }
+
+    void rewrite(const File& file, const std::string& s)
+    {
+	std::ofstream os(file.dir + "/.species.snapshot");
+	os << s;
+    }
+
+    /**
+     * Where the snapshot 's' has its slot count.
+     */
+    size_t index_of(const std::string& s)
+    {
+	for(uint32_t m = 1; 8*m + 4 <= s.size(); m *= 2) {
+	    const size_t i = s.size() - 8*m - 4;
+	    uint32_t k;
+	    std::memcpy(&k, s.data() + i, sizeof k);
+	    if(k==m) return i;
+	}
+	orchis::assert_(false);
+	return 0;
+    }
+
+    /**
+     * Overwrite the snapshot's slot count with 'n', and cut off
+     * the slots themselves.
+     */
+    void truncate_index(const File& file, const uint32_t n)
+    {
+	std::string s = snapshot_of(file);
+	s.resize(index_of(s));
+	s.append(reinterpret_cast<const char*>(&n), sizeof n);
+	rewrite(file, s);
+    }
+
+    /**
+     * Give the taxon 'id' to the snapshot's names -- and with 'fill',
+     * to the empty slots too, so there are none.
+     */
+    void mangle_index(const File& file, const uint32_t id, const bool fill)
+    {
+	std::string s = snapshot_of(file);
+	const size_t i = index_of(s);
+	uint32_t n;
+	std::memcpy(&n, s.data() + i, sizeof n);
+	std::vector<uint32_t> slots(2 * n);
+	std::memcpy(slots.data(), s.data() + i + 4, 8 * n);
+	uint32_t offset = 0;
+	for(uint32_t j = 0; j < n; j++) {
+	    if(slots[2*j]) offset = slots[2*j];
+	}
+	for(uint32_t j = 0; j < n; j++) {
+	    if(fill && !slots[2*j]) slots[2*j] = offset;
+	    if(slots[2*j]) slots[2*j + 1] = id;
+	}
+	std::memcpy(&s[i + 4], slots.data(), 8 * n);
+	rewrite(file, s);
+    }
+
+    void snapshot_corrupt(TC)
+    {
+	const File file(species);
+	std::string err;
+	const std::string s = file.read(err);
+
+	truncate_index(file, 0);
+	orchis::assert_eq(file.read(err), s);
+	truncate_index(file, 1 << 29);
+	orchis::assert_eq(file.read(err), s);
+
+	mangle_index(file, 0, false);
+	orchis::assert_eq(file.read(err), s);
+	mangle_index(file, 1000, false);
+	orchis::assert_eq(file.read(err), s);
+	mangle_index(file, 1, true);
+	orchis::assert_eq(file.read(err), s);
+    }
 }
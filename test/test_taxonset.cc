@@ -0,0 +1,47 @@
+/* Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include <taxonset.h>
+#include <excursion.h>
+
+#include <orchis.h>
+
+namespace taxonset {
+
+    using orchis::TC;
+
+    void empty(TC)
+    {
+	const TaxonSet s;
+	orchis::assert_true(s.empty());
+	orchis::assert_false(s.contains(TaxonId(1)));
+	orchis::assert_false(s.contains(TaxonId(65535)));
+    }
+
+    void some(TC)
+    {
+	const TaxonSet s({TaxonId(1), TaxonId(63), TaxonId(64), TaxonId(4711)});
+	orchis::assert_false(s.empty());
+	orchis::assert_true(s.contains(TaxonId(1)));
+	orchis::assert_true(s.contains(TaxonId(63)));
+	orchis::assert_true(s.contains(TaxonId(64)));
+	orchis::assert_true(s.contains(TaxonId(4711)));
+	orchis::assert_false(s.contains(TaxonId(0)));
+	orchis::assert_false(s.contains(TaxonId(2)));
+	orchis::assert_false(s.contains(TaxonId(65)));
+	orchis::assert_false(s.contains(TaxonId(4712)));
+	orchis::assert_false(s.contains(TaxonId(9000)));
+    }
+
+    void has_one(TC)
+    {
+	FieldList ex;
+	ex.add_sighting(TaxonId(7), "foo", 3, "", 0);
+	ex.add_sighting(TaxonId(300), "bar", 3, "", 0);
+	orchis::assert_true(ex.has_one(TaxonSet({TaxonId(300)})));
+	orchis::assert_true(ex.has_one(TaxonSet({TaxonId(1), TaxonId(7)})));
+	orchis::assert_false(ex.has_one(TaxonSet({TaxonId(8), TaxonId(299)})));
+	orchis::assert_false(ex.has_one(TaxonSet()));
+    }
+}
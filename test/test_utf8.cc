@@ -1,4 +1,4 @@
-/* Copyright (c) 2017 Jrgen Grahn
+/* Copyright (c) 2017 Jörgen Grahn
  * All rights reserved.
  *
  */
@@ -1,4 +1,4 @@
-/* Copyright (c) 2017, 2018 Jrgen Grahn <grahn+src@snipabacken.se>
+/* Copyright (c) 2017, 2018 Jörgen Grahn <grahn+src@snipabacken.se>
  * All rights reserved.
  *
  * Collected from utf8(7):
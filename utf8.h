@@ -1,6 +1,6 @@
 /* -*- c++ -*-
  *
- * Copyright (c) 2017, 2018 Jrgen Grahn <grahn+src@snipabacken.se>
+ * Copyright (c) 2017, 2018 Jörgen Grahn <grahn+src@snipabacken.se>
  * All rights reserved.
  */
 #ifndef GAVIA_UTF8_H
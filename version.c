@@ -0,0 +1,3 @@
+const char* groblad_prefix(void) { return "/usr/local"; }
+const char* groblad_name(void) { return "Groblad"; }
+const char* groblad_version(void) { return "3.15"; }
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ *
+ */
+#include "workers.h"
+
+#include <memory>
+
+
+Workers::Workers(const unsigned n)
+    : done(false)
+{
+    for(unsigned i=0; i<n; i++) {
+	threads.emplace_back(&Workers::run, this);
+    }
+}
+
+
+Workers::~Workers()
+{
+    {
+	std::lock_guard<std::mutex> lock(mutex);
+	done = true;
+    }
+    cond.notify_all();
+    for(std::thread& t : threads) t.join();
+}
+
+
+/**
+ * Queue 'task' for running on one of the threads. The future becomes
+ * ready when it's done, or has thrown an exception.
+ */
+std::future<void> Workers::submit(const std::function<void ()>& task)
+{
+    auto t = std::make_shared<std::packaged_task<void ()>>(task);
+    std::future<void> f = t->get_future();
+    {
+	std::lock_guard<std::mutex> lock(mutex);
+	tasks.push_back([t] { (*t)(); });
+    }
+    cond.notify_one();
+    return f;
+}
+
+
+void Workers::run()
+{
+    for(;;) {
+	std::function<void ()> task;
+	{
+	    std::unique_lock<std::mutex> lock(mutex);
+	    while(tasks.empty() && !done) cond.wait(lock);
+	    if(tasks.empty()) return;
+	    task.swap(tasks.front());
+	    tasks.pop_front();
+	}
+	task();
+    }
+}
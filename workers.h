@@ -0,0 +1,42 @@
+/* -*- c++ -*-
+ *
+ * Copyright (c) 2026 Jörgen Grahn
+ * All rights reserved.
+ */
+#ifndef GROBLAD_WORKERS_H
+#define GROBLAD_WORKERS_H
+
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+
+/**
+ * A fixed set of threads, running tasks in the order they were
+ * submitted.  The destructor waits for all of them to finish.
+ */
+class Workers {
+public:
+    explicit Workers(unsigned n);
+    ~Workers();
+
+    std::future<void> submit(const std::function<void ()>& task);
+
+private:
+    Workers(const Workers&);
+    Workers& operator= (const Workers&);
+
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::function<void ()>> tasks;
+    bool done;
+    std::vector<std::thread> threads;
+};
+
+#endif